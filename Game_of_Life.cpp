@@ -7,6 +7,7 @@
  * @date March, 2020
  */
 
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -14,7 +15,11 @@
 #include "cxxopts/cxxopts.hxx"
 
 #include "grid.h"
+#include "pipeline.h"
+#include "renderer.h"
+#include "sparse_world.h"
 #include "world.h"
+#include "world_batch.h"
 #include "zoo.h"
 
 int main(int argc, char *argv[]) {
@@ -29,6 +34,13 @@ int main(int argc, char *argv[]) {
             ("s,steps","The number of steps to simulate the world.", cxxopts::value<int>()->default_value("10"))
             ("e,every","Print world to the console every N steps. 0 disables printing.", cxxopts::value<int>()->default_value("0"))
             ("t,toroidal", "Simulate the Game of Life on a torus.", cxxopts::value<bool>()->default_value("false"))
+            ("p,sparse", "Use the sparse tiled engine, best for mostly dead universes.", cxxopts::value<bool>()->default_value("false"))
+            ("a,stats", "Collect per-phase timings and activity counters, printed after the run.", cxxopts::value<bool>()->default_value("false"))
+            ("r,rule", "The B/S rulestring to simulate, e.g. B36/S23 for HighLife.", cxxopts::value<std::string>()->default_value("B3/S23"))
+            ("d,diff", "With --every, only redraw rows that changed using cursor movement.", cxxopts::value<bool>()->default_value("false"))
+            ("l,pipeline", "Overlap stepping with rendering and saving through a snapshot ring.", cxxopts::value<bool>()->default_value("false"))
+            ("b,batch", "Run a batch of worlds, one ascii file path per line of the manifest.", cxxopts::value<std::string>())
+            ("j,threads", "The number of threads used by --batch.", cxxopts::value<int>()->default_value("4"))
             ("h,help", "Print usage.");
 
     // Actually parse the command line arguments
@@ -45,6 +57,34 @@ int main(int argc, char *argv[]) {
     const int  every    = result["every"].as<int>();
     const bool toroidal = result["toroidal"].as<bool>();
 
+    // Batch mode: advance every world of the manifest over a shared pool and
+    // print one summary line per world, instead of simulating a single world
+    if (result.count("batch")) {
+        WorldBatch batch;
+        try {
+            std::ifstream manifest(result["batch"].as<std::string>());
+            if (!manifest.is_open()) {
+                throw std::runtime_error("Couldn't open manifest");
+            }
+            std::string line;
+            while (std::getline(manifest, line)) {
+                if (!line.empty()) {
+                    batch.add(World(Zoo::load_ascii(line)));
+                }
+            }
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        batch.advance_all(steps, toroidal, result["threads"].as<int>());
+        for (int i = 0; i < batch.get_world_count(); i++) {
+            std::cout << "World " << i << " | Alive " << batch.get_world(i).get_alive_cells()
+                      << " | Dead " << batch.get_world(i).get_dead_cells() << std::endl;
+        }
+        return 0;
+    }
+
     // Start with an empty grid
     Grid grid;
 
@@ -59,34 +99,129 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    // Construct a world from the parsed grid
-    World world(grid);
+    // Construct a world from the parsed grid, using the engine selected on the command line.
+    // The sparse engine only stores and steps tiles containing alive cells, so it wins
+    // when the universe is mostly dead; the dense engine wins on busy universes.
+    World world;
+    SparseWorld sparse_world;
+    const bool sparse = result["sparse"].as<bool>();
+    const bool stats  = result["stats"].as<bool>();
+    if (sparse) {
+        sparse_world = SparseWorld(grid);
+        if (stats) {
+            std::cerr << "--stats is only collected by the dense engine, ignoring it with --sparse" << std::endl;
+        }
+        if (result["rule"].as<std::string>() != "B3/S23") {
+            std::cerr << "--rule is only supported by the dense engine, ignoring it with --sparse" << std::endl;
+        }
+    }
+    else {
+        // The grid is not needed again on this path, hand its buffer to the world
+        world = World(std::move(grid));
+        world.set_stats_enabled(stats);
+        try {
+            world.set_rule(Rule(result["rule"].as<std::string>()));
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+    }
 
     // Print the initial state of the grid
-    std::cout << "Initial state..." << std::endl
-              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl
-              << world.get_state() << std::endl;
-
-    // Perform the requested number of update steps
-    for (int step = 0; step < steps; step++) {
-        world.step(toroidal);
-
-        // Print the state of the grid every N steps
-        if ((every > 0) && (step % every == 0)) {
-            std::cout << "Step " << (step + 1) << " of " << steps << std::endl
-                      << world.get_state() << std::endl;
+    std::cout << "Initial state..." << std::endl;
+    if (sparse) {
+        std::cout << "Alive " << sparse_world.get_alive_cells() << " | Dead " << sparse_world.get_dead_cells() << std::endl
+                  << sparse_world.get_state() << std::endl;
+    }
+    else {
+        std::cout << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells() << std::endl
+                  << world.get_state() << std::endl;
+    }
+
+    // The live view renderer assembles frames into one buffer and bulk writes them,
+    // optionally redrawing only changed rows, so --every 1 no longer outpaces the step
+    const bool diff = result["diff"].as<bool>();
+    Renderer renderer(diff);
+
+    // In pipeline mode the console and file stages run on their own threads fed by
+    // a small ring of snapshots, so generation N+1 computes while N renders and an
+    // earlier snapshot is still being written to the output file
+    if (result["pipeline"].as<bool>()) {
+        const std::string save_path = result.count("output") ? result["output"].as<std::string>() : "";
+        GenerationPipeline pipeline(every > 0, diff, save_path);
+        for (int step = 0; step < steps; step++) {
+            if (sparse) {
+                sparse_world.step(toroidal);
+            }
+            else {
+                world.step(toroidal);
+            }
+            if ((every > 0 && (step % every == 0)) || (!save_path.empty() && step + 1 == steps)) {
+                Grid snapshot = sparse ? sparse_world.get_state() : world.get_state();
+                pipeline.submit(std::move(snapshot), step + 1, steps);
+            }
+        }
+        pipeline.finish();
+    }
+    else {
+        // Perform the requested number of update steps
+        for (int step = 0; step < steps; step++) {
+            if (sparse) {
+                sparse_world.step(toroidal);
+            }
+            else {
+                world.step(toroidal);
+            }
+
+            // Print the state of the grid every N steps. In diff mode the frame is
+            // redrawn in place, so the per-step header would break the cursor math.
+            if ((every > 0) && (step % every == 0)) {
+                if (!diff) {
+                    std::cout << "Step " << (step + 1) << " of " << steps << std::endl;
+                }
+                if (sparse) {
+                    const Grid state = sparse_world.get_state();
+                    renderer.render(std::cout, GridView(state));
+                }
+                else {
+                    renderer.render(std::cout, world.view());
+                }
+            }
         }
     }
 
     // Print the final state of the grid
-    std::cout << "Final state..." << std::endl
-              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl
-              << world.get_state() << std::endl;
+    std::cout << "Final state..." << std::endl;
+    if (sparse) {
+        std::cout << "Alive " << sparse_world.get_alive_cells() << " | Dead " << sparse_world.get_dead_cells() << std::endl
+                  << sparse_world.get_state() << std::endl;
+    }
+    else {
+        std::cout << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells() << std::endl
+                  << world.get_state() << std::endl;
+    }
+
+    // Print the collected performance counters, the cells changed per generation
+    // number is the signal for moving a workload to the sparse engine
+    if (stats && !sparse) {
+        const WorldStats &s = world.get_stats();
+        const double gens = s.generations > 0 ? double(s.generations) : 1.0;
+        std::cout << "Stats..." << std::endl
+                  << "Generations " << s.generations << std::endl
+                  << "Cells evaluated " << s.cells_evaluated << " (" << (s.cells_evaluated / gens) << " per generation)" << std::endl
+                  << "Cells changed " << s.cells_changed << " (" << (s.cells_changed / gens) << " per generation)" << std::endl
+                  << "Tiles evaluated " << s.tiles_evaluated << " | copied " << s.tiles_copied << std::endl
+                  << "Alive delta " << s.alive_delta << std::endl
+                  << "Phase seconds: prepare " << s.prepare_seconds
+                  << " | evaluate " << s.evaluate_seconds
+                  << " | swap " << s.swap_seconds << std::endl << std::endl;
+    }
 
     // Attempt to save to the output directory if a path was given
     if (result.count("output")) {
         try {
-            Zoo::save_ascii(result["output"].as<std::string>(), world.get_state());
+            Zoo::save_ascii(result["output"].as<std::string>(), sparse ? sparse_world.get_state() : world.get_state());
         }
         catch (const std::exception &ex) {
             std::cerr << ex.what() << std::endl;
@@ -0,0 +1,206 @@
+/**
+ * Microbenchmark suite for the Game of Life engines and i/o.
+ *
+ * Times World::step (bounded and toroidal, several grid sizes), the Grid
+ * merge/crop/rotate operations, and the Zoo binary load/save paths. Every
+ * benchmark runs warm-up iterations first, then reports the median of the
+ * timed repetitions so one scheduler hiccup cannot fake a regression, and
+ * prints one machine-readable JSON array on stdout for release gating.
+ *
+ * Build it like the Game_of_Life binary, from the same sources:
+ * g++ -std=c++17 -O2 grid.cpp world.cpp zoo.cpp Game_of_Life_bench.cpp -o Game_of_Life_bench -pthread
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "grid.h"
+#include "world.h"
+#include "zoo.h"
+
+/**
+ * median_seconds(body, warmup, reps)
+ *
+ * Run a benchmark body warmup times untimed, then reps times timed, and
+ * return the median of the timed runs in seconds.
+ *
+ * @param body
+ *      The operation being measured.
+ *
+ * @param warmup
+ *      The number of untimed runs to warm caches and allocators.
+ *
+ * @param reps
+ *      The number of timed runs to take the median over.
+ *
+ * @return
+ *      The median time of one run in seconds.
+ */
+static double median_seconds(const std::function<void()> &body, const int warmup, const int reps)
+{
+    for (int i = 0; i < warmup; i++)
+    {
+        body();
+    }
+    std::vector<double> times;
+    for (int i = 0; i < reps; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double>(stop - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/**
+ * report(first, name, seconds, cells)
+ *
+ * Print one benchmark result as a JSON object, appending it to the array
+ * being streamed to stdout. cells of 0 omits the throughput field for
+ * benchmarks where cells per second is not meaningful.
+ *
+ * @param first
+ *      Whether this is the first result, controlling the separating comma.
+ *
+ * @param name
+ *      The benchmark name.
+ *
+ * @param seconds
+ *      The median seconds of one run.
+ *
+ * @param cells
+ *      The number of cells one run processes, 0 if not applicable.
+ */
+static void report(bool &first, const std::string &name, const double seconds, const long long cells)
+{
+    if (!first)
+    {
+        std::printf(",\n");
+    }
+    first = false;
+    if (cells > 0)
+    {
+        std::printf("  {\"name\": \"%s\", \"seconds\": %.6f, \"cells_per_second\": %.0f}",
+                    name.c_str(), seconds, cells / seconds);
+    }
+    else
+    {
+        std::printf("  {\"name\": \"%s\", \"seconds\": %.6f}", name.c_str(), seconds);
+    }
+}
+
+/**
+ * soup(size)
+ *
+ * Build a deterministic random soup grid, roughly a third alive, so every
+ * run of the suite benchmarks identical work.
+ *
+ * @param size
+ *      The edge size of the square grid.
+ *
+ * @return
+ *      The soup grid.
+ */
+static Grid soup(const int size)
+{
+    Grid grid(size);
+    unsigned int state = 12345;
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            //xorshift keeps the soup identical across runs and platforms
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            if (state % 3 == 0)
+            {
+                grid.set(x, y, Cell::ALIVE);
+            }
+        }
+    }
+    return grid;
+}
+
+int main()
+{
+    const int warmup = 2;
+    const int reps = 7;
+    bool first = true;
+
+    std::printf("[\n");
+
+    // World::step across sizes and topologies
+    for (const int size : {256, 1024, 2048})
+    {
+        for (const int toroidal : {0, 1})
+        {
+            World world(soup(size));
+            const std::string name = "world_step_" + std::to_string(size) +
+                                     (toroidal ? "_toroidal" : "_bounded");
+            double seconds = median_seconds([&world, toroidal]() {
+                world.step(toroidal != 0);
+            }, warmup, reps);
+            report(first, name, seconds, (long long)size * size);
+        }
+    }
+
+    // Grid operations on a 2048 soup
+    {
+        const Grid grid = soup(2048);
+        double seconds = median_seconds([&grid]() {
+            Grid rotated = grid.rotate(1);
+        }, warmup, reps);
+        report(first, "grid_rotate_2048", seconds, 2048LL * 2048);
+
+        seconds = median_seconds([&grid]() {
+            Grid cropped = grid.crop(512, 512, 1536, 1536);
+        }, warmup, reps);
+        report(first, "grid_crop_1024_of_2048", seconds, 1024LL * 1024);
+
+        Grid target(4096);
+        seconds = median_seconds([&target, &grid]() {
+            target.merge(grid, 1024, 1024);
+        }, warmup, reps);
+        report(first, "grid_merge_2048_into_4096", seconds, 2048LL * 2048);
+    }
+
+    // Zoo binary i/o on a 2048 soup
+    {
+        const Grid grid = soup(2048);
+        const std::string path = "bench_scratch.bgol";
+        double seconds = median_seconds([&path, &grid]() {
+            Zoo::save_binary(path, grid);
+        }, warmup, reps);
+        report(first, "zoo_save_binary_2048", seconds, 2048LL * 2048);
+
+        seconds = median_seconds([&path]() {
+            Grid loaded = Zoo::load_binary(path);
+        }, warmup, reps);
+        report(first, "zoo_load_binary_2048", seconds, 2048LL * 2048);
+
+        seconds = median_seconds([&path, &grid]() {
+            Zoo::save_binary_mmap(path, grid);
+        }, warmup, reps);
+        report(first, "zoo_save_binary_mmap_2048", seconds, 2048LL * 2048);
+
+        seconds = median_seconds([&path]() {
+            Grid loaded = Zoo::load_binary_mmap(path);
+        }, warmup, reps);
+        report(first, "zoo_load_binary_mmap_2048", seconds, 2048LL * 2048);
+
+        std::remove(path.c_str());
+    }
+
+    std::printf("\n]\n");
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * Declares classes for recording and replaying the full history of a simulation.
+ * Rich documentation for the api and behaviour of the DeltaWriter and DeltaReader
+ * classes can be found in delta_stream.cpp.
+ *
+ * Full snapshots of every generation are impossibly large, but typically under
+ * a couple of percent of cells change per generation. The delta stream stores
+ * one keyframe every so often and, between keyframes, only the cells that
+ * flipped - as runs of consecutive cell indices - so capturing every
+ * generation of a long run becomes affordable, and any generation can be
+ * reconstructed by replaying a few deltas from the nearest keyframe.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the classes.
+// #include ...
+#include "grid.h"
+#include <fstream>
+#include <string>
+
+/**
+ * Declare the structure of the DeltaWriter class for appending generations to a stream file.
+ */
+class DeltaWriter
+{
+private:
+    std::ofstream file;
+    std::vector<std::uint64_t> last;
+    int width;
+    int height;
+    int keyframe_interval;
+    int frames;
+    void pack(const Grid &state, std::vector<std::uint64_t> &words) const;
+    void write_keyframe(const std::vector<std::uint64_t> &words);
+    void write_delta(const std::vector<std::uint64_t> &words);
+
+public:
+    DeltaWriter(const std::string &path, const Grid &initial_state, const int keyframe_interval = 256);
+    void record(const Grid &state);
+    int get_frame_count() const;
+};
+
+/**
+ * Declare the structure of the DeltaReader class for reconstructing any recorded generation.
+ */
+class DeltaReader
+{
+private:
+    struct FrameIndex
+    {
+        long offset;
+        bool keyframe;
+    };
+    std::ifstream file;
+    std::vector<FrameIndex> frames;
+    int width;
+    int height;
+
+public:
+    DeltaReader(const std::string &path);
+    int get_frame_count() const;
+    int get_width() const;
+    int get_height() const;
+    Grid state_at(const int generation);
+};
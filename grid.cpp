@@ -15,8 +15,11 @@
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
 #include "grid.h"
+#include <bitset>
+#include <cstring>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 /**
  * Grid::Grid()
  *
@@ -30,7 +33,7 @@
  *
  */
 
-Grid::Grid() : height(0), width(0)
+Grid::Grid() : height(0), width(0), packed(false), alive_count(0), count_valid(true)
 {
 }
 /**
@@ -76,15 +79,159 @@ Grid::Grid(const int square_size) : Grid(square_size, square_size)
  * @param height
  *      The height of the grid.
  */
-Grid::Grid(const int _width, const int _height) : height(_height), width(_width)
+Grid::Grid(const int _width, const int _height) : Grid(_width, _height, false)
+{
+}
+
+/**
+ * Grid::Grid(width, height, packed)
+ *
+ * Construct a grid with the desired size filled with dead cells, selecting the storage backend.
+ *
+ * When packed = false each cell is stored as one Cell (one byte).
+ * When packed = true cells are stored one bit each, 64 cells per 64 bit word,
+ * cutting memory use 8x for very large grids. A packed grid supports the same
+ * get/set/count/crop/rotate/merge api, but cannot hand out Cell references
+ * through Grid::operator()(x, y) because there is no addressable Cell to refer to.
+ *
+ * @example
+ *
+ *      // Make a bit-packed 1024x1024 grid
+ *      Grid grid(1024, 1024, true);
+ *
+ * @param width
+ *      The width of the grid.
+ *
+ * @param height
+ *      The height of the grid.
+ *
+ * @param packed
+ *      If true then use the bit-packed storage backend.
+ */
+Grid::Grid(const int _width, const int _height, const bool _packed)
+    : height(_height), width(_width), packed(_packed), alive_count(0), count_valid(true)
 {
     int totalcells = get_total_cells();
-    for (int i = 0; i < totalcells; i++)
+    if (packed)
+    {
+        //one bit per cell, 64 cells per word, rounded up
+        words.resize((totalcells + 63) / 64, 0);
+    }
+    else
     {
-        grid.push_back(Cell::DEAD);
+        for (int i = 0; i < totalcells; i++)
+        {
+            grid.push_back(Cell::DEAD);
+        }
     }
 }
 
+/**
+ * Grid::Grid(other)
+ *
+ * Copy construct a grid. Written out by hand only because the atomic
+ * count members are not copyable on their own; the semantics are the
+ * plain member-wise copy.
+ *
+ * @param other
+ *      The grid to copy.
+ */
+Grid::Grid(const Grid &other)
+    : height(other.height), width(other.width), packed(other.packed),
+      grid(other.grid), words(other.words),
+      alive_count(other.alive_count.load()), count_valid(other.count_valid.load())
+{
+}
+
+/**
+ * Grid::operator=(other)
+ *
+ * Copy assign a grid, see the copy constructor above.
+ *
+ * @param other
+ *      The grid to copy.
+ *
+ * @return
+ *      Returns a reference to this grid to enable operator chaining.
+ */
+Grid &Grid::operator=(const Grid &other)
+{
+    height = other.height;
+    width = other.width;
+    packed = other.packed;
+    grid = other.grid;
+    words = other.words;
+    alive_count = other.alive_count.load();
+    count_valid = other.count_valid.load();
+    return *this;
+}
+
+/**
+ * Grid::Grid(other)
+ *
+ * Move construct a grid, stealing the buffer of another in O(1).
+ * The moved-from grid is left as an empty 0x0 grid, so a multi-gigabyte
+ * buffer is never silently duplicated when handing a grid to a World or
+ * another owner.
+ *
+ * @example
+ *
+ *      // Hand a freshly built grid to its new owner without a copy
+ *      Grid pattern = Zoo::load_ascii("huge.gol");
+ *      Grid owned = std::move(pattern);
+ *
+ * @param other
+ *      The grid to move from, left empty.
+ */
+Grid::Grid(Grid &&other) : Grid()
+{
+    *this = std::move(other);
+}
+
+/**
+ * Grid::operator=(other)
+ *
+ * Move assign a grid, see the move constructor above.
+ *
+ * @param other
+ *      The grid to move from, left empty.
+ *
+ * @return
+ *      Returns a reference to this grid to enable operator chaining.
+ */
+Grid &Grid::operator=(Grid &&other)
+{
+    height = other.height;
+    width = other.width;
+    packed = other.packed;
+    grid = std::move(other.grid);
+    words = std::move(other.words);
+    alive_count = other.alive_count.load();
+    count_valid = other.count_valid.load();
+    other.height = 0;
+    other.width = 0;
+    other.packed = false;
+    other.grid.clear();
+    other.words.clear();
+    other.alive_count = 0;
+    other.count_valid = true;
+    return *this;
+}
+
+/**
+ * Grid::is_packed()
+ *
+ * Returns whether the grid uses the bit-packed storage backend.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      True if the grid stores one bit per cell, false if it stores one Cell per cell.
+ */
+bool Grid::is_packed() const
+{
+    return packed;
+}
+
 /**
  * Grid::get_width()
  *
@@ -195,15 +342,87 @@ int Grid::get_total_cells() const
  */
 int Grid::get_alive_cells() const
 {
-    int alive = 0;
-    for (int i = 0; i < get_total_cells(); i++)
+    if (!count_valid)
+    {
+        recount();
+    }
+    return alive_count;
+}
+
+/**
+ * Grid::recount()
+ *
+ * Private helper function rebuilding the running alive count after raw
+ * buffer access has invalidated it. Small grids are counted inline; large
+ * grids split the buffer across a few threads so a monitoring poll does
+ * not pin a core for the whole scan.
+ */
+void Grid::recount() const
+{
+    //below this many cells the scan is cheaper than spawning threads
+    const int parallel_threshold = 1 << 22;
+    const int total = get_total_cells();
+    const int n_threads = total >= parallel_threshold ? 4 : 1;
+
+    std::vector<long long> partial(n_threads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; t++)
     {
-        if (grid[i] == Cell::ALIVE)
+        long long *sum = &partial[t];
+        if (packed)
+        {
+            std::size_t begin = words.size() * t / n_threads;
+            std::size_t end = words.size() * (t + 1) / n_threads;
+            auto body = [this, begin, end, sum]() {
+                //population count of each word, the padding bits are always 0
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    *sum += std::bitset<64>(words[i]).count();
+                }
+            };
+            if (n_threads > 1)
+            {
+                threads.push_back(std::thread(body));
+            }
+            else
+            {
+                body();
+            }
+        }
+        else
         {
-            alive++;
+            int begin = int((long long)total * t / n_threads);
+            int end = int((long long)total * (t + 1) / n_threads);
+            auto body = [this, begin, end, sum]() {
+                for (int i = begin; i < end; i++)
+                {
+                    if (grid[i] == Cell::ALIVE)
+                    {
+                        (*sum)++;
+                    }
+                }
+            };
+            if (n_threads > 1)
+            {
+                threads.push_back(std::thread(body));
+            }
+            else
+            {
+                body();
+            }
         }
     }
-    return alive;
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    long long alive = 0;
+    for (const long long sum : partial)
+    {
+        alive += sum;
+    }
+    alive_count = int(alive);
+    count_valid = true;
 }
 
 /**
@@ -231,15 +450,7 @@ int Grid::get_alive_cells() const
  */
 int Grid::get_dead_cells() const
 {
-    int dead = 0;
-    for (int i = 0; i < get_total_cells(); i++)
-    {
-        if (grid[i] == Cell::DEAD)
-        {
-            dead++;
-        }
-    }
-    return dead;
+    return get_total_cells() - get_alive_cells();
 }
 /**
  * Grid::resize(square_size)
@@ -284,27 +495,16 @@ void Grid::resize(int square_size)
  */
 void Grid::resize(const int new_width, const int new_height)
 {
-    std::vector<Cell> newGrid;
-    for (int y = 0; y < new_height; y++)
+    //build a new grid with the same storage backend, new cells default to dead
+    Grid newGrid = Grid(new_width, new_height, packed);
+    for (int y = 0; y < new_height && y < height; y++)
     {
-        for (int x = 0; x < new_width; x++)
+        for (int x = 0; x < new_width && x < width; x++)
         {
-            if (x > width - 1 || y > height - 1)
-            {
-                //the new grid is larger
-                //Default is dead :(
-                newGrid.push_back(Cell::DEAD);
-            }
-            else
-            {
-                newGrid.push_back(grid[get_index(x, y)]);
-            }
+            newGrid.set(x, y, get(x, y));
         }
     }
-    grid.clear();
-    grid = newGrid;
-    width = new_width;
-    height = new_height;
+    *this = newGrid;
 }
 
 /**
@@ -365,12 +565,19 @@ const Cell Grid::get(const int x, const int y) const
         errs << "X is out of range. X is " << x << " min is 0, max is " << width - 1;
         throw std::length_error(errs.str());
     }
-    else if (y > height || x < 0)
+    else if (y > height || y < 0)
     {
         std::ostringstream errs;
         errs << "Y is out of range. Y is " << y << " min is 0, max is " << height - 1;
         throw std::length_error(errs.str());
     }
+    if (packed)
+    {
+        //extract the single bit for this cell from its word
+        int loc = get_index(x, y);
+        std::uint64_t word = words[loc / 64];
+        return ((word >> (loc % 64)) & 1) ? Cell::ALIVE : Cell::DEAD;
+    }
     return (*this)(x, y);
 }
 /**
@@ -401,16 +608,46 @@ const Cell Grid::get(const int x, const int y) const
  */
 void Grid::set(const int x, const int y, const Cell value)
 {
-    if (x > width)
+    if (x > width || x < 0)
     {
         throw std::length_error("X is out of range");
     }
-    else if (y > height)
+    else if (y > height || y < 0)
     {
         throw std::length_error("Y is out of range");
     }
-    //Below is for our operator, I think it looks nice
-    (*this)(x, y) = value;
+    if (packed)
+    {
+        //set or clear the single bit for this cell in its word
+        int loc = get_index(x, y);
+        std::uint64_t mask = std::uint64_t(1) << (loc % 64);
+        bool was_alive = (words[loc / 64] & mask) != 0;
+        if (value == Cell::ALIVE)
+        {
+            words[loc / 64] |= mask;
+        }
+        else
+        {
+            words[loc / 64] &= ~mask;
+        }
+        if (count_valid)
+        {
+            //keep the running count current, one compare per set
+            alive_count += int(value == Cell::ALIVE) - int(was_alive);
+        }
+        return;
+    }
+    int loc = get_index(x, y);
+    if (x < 0 || y < 0 || loc >= int(grid.size()))
+    {
+        throw std::out_of_range("X or Y out of range");
+    }
+    if (count_valid)
+    {
+        //keep the running count current, one compare per set
+        alive_count += int(value == Cell::ALIVE) - int(grid[loc] == Cell::ALIVE);
+    }
+    grid[loc] = value;
 }
 /**
  * Grid::operator()(x, y)
@@ -449,10 +686,17 @@ void Grid::set(const int x, const int y, const Cell value)
  */
 Cell &Grid::operator()(const int x, const int y)
 {
+    if (packed)
+    {
+        //a packed cell is a single bit, there is no Cell to take a reference to
+        throw std::logic_error("Cannot reference a cell of a bit-packed grid, use get/set instead");
+    }
     if (x > width || y > height || x < 0 || y < 0)
     {
         throw std::out_of_range("X or Y out of range");
     }
+    //the caller may write through the reference, the count can no longer be trusted
+    count_valid = false;
     int loc = get_index(x, y);
 
     try
@@ -496,6 +740,11 @@ Cell &Grid::operator()(const int x, const int y)
  */
 const Cell &Grid::operator()(const int x, const int y) const
 {
+    if (packed)
+    {
+        //a packed cell is a single bit, there is no Cell to take a reference to
+        throw std::logic_error("Cannot reference a cell of a bit-packed grid, use get/set instead");
+    }
     if (x > width || y > height || x < 0 || y < 0)
     {
         throw std::out_of_range("X or Y out of range");
@@ -510,6 +759,136 @@ const Cell &Grid::operator()(const int x, const int y) const
         throw ex;
     }
 }
+/**
+ * Grid::row_data(y)
+ *
+ * Gets a read-only pointer to the first cell of the desired row.
+ * The cells of a row are stored contiguously, so the pointer addresses
+ * width cells and lets hot loops stream a whole row without per-cell
+ * bounds checks. The function should be callable from a constant context.
+ *
+ * Only valid for the byte-per-cell backend. A bit-packed grid has no
+ * addressable Cell objects to point into, matching Grid::operator()(x, y).
+ *
+ * @param y
+ *      The y coordinate of the row to access.
+ *
+ * @return
+ *      A read-only pointer to the first cell of the row.
+ *
+ * @throws
+ *      std::exception or sub-class if y is not a valid row or the grid is bit-packed.
+ */
+const Cell *Grid::row_data(const int y) const
+{
+    if (packed)
+    {
+        //a packed row is a run of bits, there are no Cells to point to
+        throw std::logic_error("Cannot address the cells of a bit-packed grid, use get/set instead");
+    }
+    if (y < 0 || y >= height)
+    {
+        throw std::out_of_range("Y out of range");
+    }
+    return grid.data() + get_index(0, y);
+}
+
+/**
+ * Grid::row_data(y)
+ *
+ * Gets a modifiable pointer to the first cell of the desired row.
+ * See the constant overload above for the full behaviour.
+ *
+ * @param y
+ *      The y coordinate of the row to access.
+ *
+ * @return
+ *      A modifiable pointer to the first cell of the row.
+ *
+ * @throws
+ *      std::exception or sub-class if y is not a valid row or the grid is bit-packed.
+ */
+Cell *Grid::row_data(const int y)
+{
+    if (packed)
+    {
+        //a packed row is a run of bits, there are no Cells to point to
+        throw std::logic_error("Cannot address the cells of a bit-packed grid, use get/set instead");
+    }
+    if (y < 0 || y >= height)
+    {
+        throw std::out_of_range("Y out of range");
+    }
+    //the caller may write through the pointer, the count can no longer be trusted
+    count_valid = false;
+    return grid.data() + get_index(0, y);
+}
+
+/**
+ * Grid::word_data()
+ *
+ * Gets a read-only pointer to the packed words of a bit-packed grid.
+ * The words hold 64 cells each in row major order, one bit per cell,
+ * exactly as stored in memory, so bulk i/o can move whole grids without
+ * converting cell by cell. The function should be callable from a constant context.
+ *
+ * Only valid for the bit-packed backend, mirroring how Grid::row_data(y)
+ * is only valid for the byte-per-cell backend.
+ *
+ * @return
+ *      A read-only pointer to the first packed word.
+ *
+ * @throws
+ *      std::exception or sub-class if the grid is not bit-packed.
+ */
+const std::uint64_t *Grid::word_data() const
+{
+    if (!packed)
+    {
+        throw std::logic_error("Cannot address the words of a byte-per-cell grid, use row_data instead");
+    }
+    return words.data();
+}
+
+/**
+ * Grid::word_data()
+ *
+ * Gets a modifiable pointer to the packed words of a bit-packed grid.
+ * See the constant overload above for the full behaviour.
+ *
+ * @return
+ *      A modifiable pointer to the first packed word.
+ *
+ * @throws
+ *      std::exception or sub-class if the grid is not bit-packed.
+ */
+std::uint64_t *Grid::word_data()
+{
+    if (!packed)
+    {
+        throw std::logic_error("Cannot address the words of a byte-per-cell grid, use row_data instead");
+    }
+    //the caller may write through the pointer, the count can no longer be trusted
+    count_valid = false;
+    return words.data();
+}
+
+/**
+ * Grid::get_total_words()
+ *
+ * Gets the number of packed words a bit-packed grid of this size occupies,
+ * 64 cells per word rounded up. The function should be callable from a
+ * constant context and is valid for both storage backends, so callers can
+ * size packed buffers for any grid.
+ *
+ * @return
+ *      The number of 64 bit words needed to hold every cell of the grid.
+ */
+int Grid::get_total_words() const
+{
+    return (get_total_cells() + 63) / 64;
+}
+
 /**
  * Grid::crop(x0, y0, x1, y1)
  *
@@ -557,7 +936,7 @@ Grid Grid::crop(const int x0, const int y0, const int x1, const int y1) const
 
     int _width = x1 - x0;
     int _height = y1 - y0;
-    Grid newGrid = Grid(_width, _height);
+    Grid newGrid = Grid(_width, _height, packed);
     for (int y = 0; y < _height; y++)
     {
         for (int x = 0; x < _width; x++)
@@ -567,6 +946,60 @@ Grid Grid::crop(const int x0, const int y0, const int x1, const int y1) const
     }
     return newGrid;
 }
+/**
+ * Grid::crop(x0, y0, x1, y1, arena)
+ *
+ * Extract a sub-grid from a Grid, placing the result in a pooled buffer from
+ * the arena instead of allocating one. Behaviour is otherwise identical to
+ * Grid::crop(x0, y0, x1, y1); the result uses the byte-per-cell backend.
+ * Release the result back to the arena when done to complete the cycle.
+ *
+ * @param x0
+ *      Left coordinate of the crop window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the crop window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the crop window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the crop window on y-axis (1 greater than the largest index).
+ *
+ * @param arena
+ *      The arena supplying the result buffer.
+ *
+ * @return
+ *      A new grid of the cropped size containing the values extracted from the original grid.
+ *
+ * @throws
+ *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
+ *      or if the crop window has a negative size.
+ */
+Grid Grid::crop(const int x0, const int y0, const int x1, const int y1, GridArena &arena) const
+{
+    if (x0 < 0 || x1 > width || y0 < 0 || y1 > height)
+    {
+        throw std::length_error("the coordinates are not within the grid");
+    }
+    else if (x0 > x1 || y0 > y1)
+    {
+        throw std::length_error("Crop is a negative window");
+    }
+
+    int _width = x1 - x0;
+    int _height = y1 - y0;
+    Grid newGrid = Grid(_width, _height, arena.acquire(_width * _height));
+    for (int y = 0; y < _height; y++)
+    {
+        for (int x = 0; x < _width; x++)
+        {
+            newGrid.set(x, y, get(x + x0, y + y0));
+        }
+    }
+    return newGrid;
+}
+
 /**
  * Grid::merge(other, x0, y0, alive_only = false)
  *
@@ -613,6 +1046,58 @@ void Grid::merge(const Grid &other, const int x0, const int y0, const bool alive
     {
         throw std::length_error("Other grid doesn't fit on original grid");
     }
+    if (!packed && !other.packed)
+    {
+        //row-wise kernel over the raw buffers: an overwriting merge is one
+        //memcpy per row, an alive-only merge a tight per-byte loop. Large
+        //merges split the rows over a few threads.
+        count_valid = false;
+        const Cell *src_base = other.grid.data();
+        Cell *dst_base = grid.data();
+        const int dst_width = width;
+        const int src_width = other.width;
+        auto rows = [src_base, dst_base, dst_width, src_width, x0, y0, alive_only](const int ya, const int yb) {
+            for (int y = ya; y < yb; y++)
+            {
+                const Cell *src = src_base + (long)y * src_width;
+                Cell *dst = dst_base + (long)(y + y0) * dst_width + x0;
+                if (!alive_only)
+                {
+                    std::memcpy(dst, src, src_width);
+                    continue;
+                }
+                for (int x = 0; x < src_width; x++)
+                {
+                    //Only bring the dead back to life
+                    if (src[x] == Cell::ALIVE)
+                    {
+                        dst[x] = Cell::ALIVE;
+                    }
+                }
+            }
+        };
+        //below this many cells the copy is cheaper than spawning threads
+        const long parallel_threshold = 1L << 22;
+        if ((long)other.width * other.height < parallel_threshold)
+        {
+            rows(0, other.height);
+            return;
+        }
+        const int n_threads = 4;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n_threads; t++)
+        {
+            int ya = (int)((long)other.height * t / n_threads);
+            int yb = (int)((long)other.height * (t + 1) / n_threads);
+            threads.push_back(std::thread(rows, ya, yb));
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        return;
+    }
+    //mixed or bit-packed backends go cell by cell through get/set
     for (int y = 0; y < other.height; y++)
     {
         for (int x = 0; x < other.width; x++)
@@ -622,18 +1107,55 @@ void Grid::merge(const Grid &other, const int x0, const int y0, const bool alive
             if (alive_only)
             {
                 //Only bring the dead back to life
-                if (other(x, y) == Cell::ALIVE)
+                if (other.get(x, y) == Cell::ALIVE)
                 {
-                    (*this)(curx, cury) = Cell::ALIVE;
+                    set(curx, cury, Cell::ALIVE);
                 }
             }
             else
             {
-                (*this)(curx, cury) = other(x, y);
+                set(curx, cury, other.get(x, y));
             }
         }
     }
 }
+/**
+ * Grid::merge(other, x0, y0, alive_only = false)
+ *
+ * Merge a temporary grid into the current grid. When the temporary covers
+ * this grid exactly - same size, placed at the origin, overwriting rather
+ * than alive-only - the whole buffer is stolen in O(1) instead of copying
+ * cell by cell, which is the common shape of seeding pipelines feeding
+ * Zoo creatures or crops straight into a world-sized grid. Every other
+ * shape falls through to the copying merge.
+ *
+ * @param other
+ *      The temporary grid to merge into the current grid, possibly consumed.
+ *
+ * @param x0
+ *      The x coordinate of where to place the top left corner of the other grid.
+ *
+ * @param y0
+ *      The y coordinate of where to place the top left corner of the other grid.
+ *
+ * @param alive_only
+ *      Optional parameter. If true then merging only sets alive cells to alive. Defaults to false.
+ *
+ * @throws
+ *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
+ */
+void Grid::merge(Grid &&other, const int x0, const int y0, const bool alive_only)
+{
+    if (!alive_only && x0 == 0 && y0 == 0 &&
+        other.width == width && other.height == height && other.packed == packed)
+    {
+        //the merge replaces this grid entirely, steal the buffer
+        *this = std::move(other);
+        return;
+    }
+    merge(other, x0, y0, alive_only);
+}
+
 /**
  * Grid::rotate(rotation)
  *
@@ -657,6 +1179,144 @@ void Grid::merge(const Grid &other, const int x0, const int y0, const bool alive
  *      Returns a copy of the grid that has been rotated.
  */
 Grid Grid::rotate(const int _rotation) const
+{
+    const int rot = (4 + (_rotation % 4)) % 4;
+    int _width, _height;
+    if (rot == 1 || rot == 3)
+    {
+        _width = height;
+        _height = width;
+    }
+    else
+    {
+        _width = width;
+        _height = height;
+    }
+    Grid newGrid = Grid(_width, _height, packed);
+    if (!packed)
+    {
+        //cache-blocked kernel over the raw buffers: a 90 or 270 degree
+        //rotation is a scattered transpose, so walking 64x64 tiles keeps
+        //both the source reads and destination writes within a few cache
+        //lines instead of striding the whole destination per cell. Large
+        //grids split the tile rows over a few threads.
+        const int tile = 64;
+        const Cell *src_base = grid.data();
+        Cell *dst_base = newGrid.grid.data();
+        const int w = width;
+        const int h = height;
+        auto tiles = [src_base, dst_base, w, h, _width, _height, rot](const int ty_a, const int ty_b) {
+            for (int ty = ty_a; ty < ty_b; ty += tile)
+            {
+                for (int tx = 0; tx < w; tx += tile)
+                {
+                    const int ye = ty + tile < h ? ty + tile : h;
+                    const int xe = tx + tile < w ? tx + tile : w;
+                    for (int y = ty; y < ye; y++)
+                    {
+                        const Cell *src = src_base + (long)y * w;
+                        for (int x = tx; x < xe; x++)
+                        {
+                            long dst;
+                            if (rot == 0)
+                            {
+                                dst = (long)y * _width + x;
+                            }
+                            else if (rot == 1)
+                            {
+                                //90
+                                dst = (long)x * _width + (_width - y - 1);
+                            }
+                            else if (rot == 2)
+                            {
+                                //180
+                                dst = (long)(_height - 1 - y) * _width + (_width - 1 - x);
+                            }
+                            else
+                            {
+                                //270 (or -90)
+                                dst = (long)(_height - x - 1) * _width + y;
+                            }
+                            dst_base[dst] = src[x];
+                        }
+                    }
+                }
+            }
+        };
+        //a rotation permutes the cells, the alive count carries over as-is
+        newGrid.alive_count = alive_count.load();
+        newGrid.count_valid = count_valid.load();
+        //below this many cells the rotation is cheaper than spawning threads
+        const long parallel_threshold = 1L << 22;
+        if ((long)w * h < parallel_threshold)
+        {
+            tiles(0, h);
+            return newGrid;
+        }
+        const int n_threads = 4;
+        //hand each thread whole tile rows so no tile is split between two
+        const int tile_rows = (h + tile - 1) / tile;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n_threads; t++)
+        {
+            int ya = (int)((long)tile_rows * t / n_threads) * tile;
+            int yb = (int)((long)tile_rows * (t + 1) / n_threads) * tile;
+            threads.push_back(std::thread(tiles, ya, yb < h ? yb : h));
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        return newGrid;
+    }
+    //the bit-packed backend goes cell by cell through get/set
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            Cell current = get(x, y);
+            if (rot == 0)
+            {
+                newGrid.set(x, y, current);
+            }
+            if (rot == 1)
+            {
+                //90
+                newGrid.set(_width - y - 1, x, current);
+            }
+            if (rot == 2)
+            {
+                //180
+                newGrid.set(_width - 1 - x, _height - 1 - y, current);
+            }
+            if (rot == 3)
+            {
+                //270 (or -90)
+                newGrid.set(y, _height - x - 1, current);
+            }
+        }
+    }
+    return newGrid;
+}
+/**
+ * Grid::rotate(rotation, arena)
+ *
+ * Create a copy of the grid rotated by a multiple of 90 degrees, placing the
+ * result in a pooled buffer from the arena instead of allocating one.
+ * Behaviour is otherwise identical to Grid::rotate(rotation); the result
+ * uses the byte-per-cell backend. Release the result back to the arena when
+ * done to complete the cycle.
+ *
+ * @param _rotation
+ *      An positive or negative integer to rotate by in 90 intervals.
+ *
+ * @param arena
+ *      The arena supplying the result buffer.
+ *
+ * @return
+ *      Returns a copy of the grid that has been rotated.
+ */
+Grid Grid::rotate(const int _rotation, GridArena &arena) const
 {
     int rot = (4 + (_rotation % 4)) % 4;
     int _width, _height;
@@ -670,41 +1330,36 @@ Grid Grid::rotate(const int _rotation) const
         _width = width;
         _height = height;
     }
-    Grid newGrid = Grid(_width, _height);
+    Grid newGrid = Grid(_width, _height, arena.acquire(_width * _height));
     for (int y = 0; y < height; y++)
     {
         for (int x = 0; x < width; x++)
         {
-            Cell current = (*this)(x, y);
+            Cell current = get(x, y);
             if (rot == 0)
             {
-                newGrid(x, y) = current;
+                newGrid.set(x, y, current);
             }
             if (rot == 1)
             {
                 //90
-                int curx = _width - y - 1;
-                int cury = x;
-                newGrid(curx, cury) = current;
+                newGrid.set(_width - y - 1, x, current);
             }
             if (rot == 2)
             {
                 //180
-                int curx = _width - 1 - x;
-                int cury = _height - 1 - y;
-                newGrid(curx, cury) = current;
+                newGrid.set(_width - 1 - x, _height - 1 - y, current);
             }
             if (rot == 3)
             {
                 //270 (or -90)
-                int curx = y;
-                int cury = _height - x - 1;
-                newGrid(curx, cury) = current;
+                newGrid.set(y, _height - x - 1, current);
             }
         }
     }
     return newGrid;
 }
+
 /**
  * operator<<(output_stream, grid)
  *
@@ -764,4 +1419,287 @@ std::ostream &operator<<(std::ostream &os, const Grid &grid)
     }
     os << "+" << std::endl;
     return os;
-}
\ No newline at end of file
+}
+/**
+ * GridView::GridView(grid)
+ *
+ * Construct a read-only view over an existing grid.
+ * The view holds only a pointer, nothing is copied, so it must not outlive
+ * the grid it observes.
+ *
+ * @example
+ *
+ *      // Observe a grid without copying it
+ *      Grid grid(1024);
+ *      GridView view(grid);
+ *      std::cout << view.get_alive_cells() << std::endl;
+ *
+ * @param grid
+ *      The grid to observe.
+ */
+GridView::GridView(const Grid &_grid) : grid(&_grid)
+{
+}
+
+/**
+ * GridView::get_width()
+ *
+ * Gets the width of the viewed grid.
+ *
+ * @return
+ *      The width of the viewed grid.
+ */
+int GridView::get_width() const
+{
+    return grid->get_width();
+}
+
+/**
+ * GridView::get_height()
+ *
+ * Gets the height of the viewed grid.
+ *
+ * @return
+ *      The height of the viewed grid.
+ */
+int GridView::get_height() const
+{
+    return grid->get_height();
+}
+
+/**
+ * GridView::get_total_cells()
+ *
+ * Gets the total number of cells in the viewed grid.
+ *
+ * @return
+ *      The number of total cells.
+ */
+int GridView::get_total_cells() const
+{
+    return grid->get_total_cells();
+}
+
+/**
+ * GridView::get_alive_cells()
+ *
+ * Counts how many cells in the viewed grid are alive.
+ *
+ * @return
+ *      The number of alive cells.
+ */
+int GridView::get_alive_cells() const
+{
+    return grid->get_alive_cells();
+}
+
+/**
+ * GridView::get_dead_cells()
+ *
+ * Counts how many cells in the viewed grid are dead.
+ *
+ * @return
+ *      The number of dead cells.
+ */
+int GridView::get_dead_cells() const
+{
+    return grid->get_dead_cells();
+}
+
+/**
+ * GridView::get(x, y)
+ *
+ * Returns the value of the cell at the desired coordinate of the viewed grid.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @return
+ *      The value of the desired cell.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ */
+const Cell GridView::get(const int x, const int y) const
+{
+    return grid->get(x, y);
+}
+
+/**
+ * GridView::row_data(y)
+ *
+ * Gets a read-only pointer to the first cell of the desired row of the
+ * viewed grid, for renderers that bulk copy whole rows. Only valid when
+ * the viewed grid uses the byte-per-cell backend, see Grid::row_data(y).
+ *
+ * @param y
+ *      The y coordinate of the row to access.
+ *
+ * @return
+ *      A read-only pointer to the first cell of the row.
+ *
+ * @throws
+ *      std::exception or sub-class if y is not a valid row or the grid is bit-packed.
+ */
+const Cell *GridView::row_data(const int y) const
+{
+    return grid->row_data(y);
+}
+
+/**
+ * GridView::is_packed()
+ *
+ * Returns whether the viewed grid uses the bit-packed storage backend.
+ *
+ * @return
+ *      True if the viewed grid stores one bit per cell.
+ */
+bool GridView::is_packed() const
+{
+    return grid->is_packed();
+}
+
+/**
+ * GridView::crop(x0, y0, x1, y1)
+ *
+ * Extract a sub-grid from the viewed grid, spanning [x0, x1) by [y0, y1).
+ * Only the cropped cells are copied, the viewed grid itself never is.
+ *
+ * @param x0
+ *      Left coordinate of the crop window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the crop window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the crop window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the crop window on y-axis (1 greater than the largest index).
+ *
+ * @return
+ *      A new grid of the cropped size containing the values extracted from the viewed grid.
+ *
+ * @throws
+ *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
+ *      or if the crop window has a negative size.
+ */
+Grid GridView::crop(const int x0, const int y0, const int x1, const int y1) const
+{
+    return grid->crop(x0, y0, x1, y1);
+}
+
+/**
+ * operator<<(output_stream, view)
+ *
+ * Serializes a viewed grid to an ascii output stream, exactly as the Grid
+ * overload does, without ever copying the grid being observed.
+ *
+ * @param os
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param view
+ *      A view of the grid to be printed.
+ *
+ * @return
+ *      Returns a reference to the output stream to enable operator chaining.
+ */
+std::ostream &operator<<(std::ostream &os, const GridView &view)
+{
+    return os << *view.grid;
+}
+
+/**
+ * Grid::Grid(width, height, buffer)
+ *
+ * Private constructor adopting an already sized buffer of dead cells, used
+ * by GridArena to build grids without touching the allocator. Only the
+ * byte-per-cell backend can live in pooled buffers.
+ *
+ * @param width
+ *      The width of the grid.
+ *
+ * @param height
+ *      The height of the grid.
+ *
+ * @param buffer
+ *      A buffer of width * height dead cells to take ownership of.
+ */
+Grid::Grid(const int _width, const int _height, std::vector<Cell> &&buffer)
+    : height(_height), width(_width), packed(false), grid(std::move(buffer)), alive_count(0), count_valid(true)
+{
+}
+
+/**
+ * GridArena::acquire(cells)
+ *
+ * Hand out a buffer of the desired size filled with dead cells, reusing the
+ * capacity of a previously released buffer when one is pooled. The buffer is
+ * intended to be adopted by a Grid via the arena-aware crop/rotate overloads.
+ *
+ * @param cells
+ *      The number of cells the buffer must hold.
+ *
+ * @return
+ *      A buffer of exactly cells dead cells.
+ */
+std::vector<Cell> GridArena::acquire(const int cells)
+{
+    if (pool.empty())
+    {
+        return std::vector<Cell>(cells, Cell::DEAD);
+    }
+    std::vector<Cell> buffer = std::move(pool.back());
+    pool.pop_back();
+    //reuse the capacity, the contents are reset to dead
+    buffer.assign(cells, Cell::DEAD);
+    return buffer;
+}
+
+/**
+ * GridArena::release(grid)
+ *
+ * Take back the buffer of a finished grid in O(1), pooling its capacity for
+ * the next acquire. The grid is consumed; releasing a bit-packed grid pools
+ * nothing since those do not use cell buffers.
+ *
+ * @example
+ *
+ *      // A crop/rotate pipeline that stops allocating once warm
+ *      GridArena arena;
+ *      for (int i = 0; i < 10000; i++) {
+ *          Grid piece = world_grid.crop(x, y, x + 64, y + 64, arena);
+ *          Grid turned = piece.rotate(1, arena);
+ *          examine(turned);
+ *          arena.release(std::move(piece));
+ *          arena.release(std::move(turned));
+ *      }
+ *
+ * @param grid
+ *      The grid whose buffer should be pooled, moved from.
+ */
+void GridArena::release(Grid &&grid)
+{
+    if (!grid.packed && !grid.grid.empty())
+    {
+        pool.push_back(std::move(grid.grid));
+    }
+    grid = Grid();
+}
+
+/**
+ * GridArena::get_pooled_buffers()
+ *
+ * Gets the number of buffers currently waiting in the pool.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The number of pooled buffers.
+ */
+int GridArena::get_pooled_buffers() const
+{
+    return pool.size();
+}
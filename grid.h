@@ -14,6 +14,8 @@
 // #include ...
 #include <vector>
 #include <ostream>
+#include <atomic>
+#include <cstdint>
 /**
  * A Cell is a char limited to two named values for Cell::DEAD and Cell::ALIVE.
  */
@@ -23,21 +25,43 @@ enum Cell : char
     ALIVE = '#'
 };
 
+class GridArena;
+
 /**
  * Declare the structure of the Grid class for representing a 2d grid of cells.
  */
 class Grid
 {
+    friend class GridArena;
+    //World places grid buffers on NUMA nodes with banded first-touch
+    //initialization, which needs the buffer-adopting constructor below
+    friend class World;
+
 private:
     int height;
     int width;
+    bool packed;
     std::vector<Cell> grid;
+    std::vector<std::uint64_t> words;
+    //running alive count, maintained by set and recounted lazily (in
+    //parallel for large grids) after raw buffer access invalidates it.
+    //Atomic because parallel step bands write one grid concurrently.
+    mutable std::atomic<int> alive_count;
+    mutable std::atomic<bool> count_valid;
     int get_index(const int x, const int y) const;
+    void recount() const;
+    Grid(const int width, const int height, std::vector<Cell> &&buffer);
 
 public:
     Grid();
     explicit Grid(const int square_size);
     Grid(const int width, const int height);
+    Grid(const int width, const int height, const bool packed);
+    Grid(const Grid &other);
+    Grid &operator=(const Grid &other);
+    Grid(Grid &&other);
+    Grid &operator=(Grid &&other);
+    bool is_packed() const;
     int get_height() const;
     int get_width() const;
     int get_total_cells() const;
@@ -47,13 +71,68 @@ public:
     void resize(const int width, const int height);
     const Cell get(const int x, const int y) const;
     void set(const int x, const int y, const Cell value);
+    const Cell *row_data(const int y) const;
+    Cell *row_data(const int y);
+    const std::uint64_t *word_data() const;
+    std::uint64_t *word_data();
+    int get_total_words() const;
     Grid crop(const int x0, const int y0, const int x1, const int y1) const;
+    Grid crop(const int x0, const int y0, const int x1, const int y1, GridArena &arena) const;
     void merge(const Grid &grid, const int x0, const int y0, const bool alive_only = false);
+    void merge(Grid &&grid, const int x0, const int y0, const bool alive_only = false);
     Grid rotate(const int rotation) const;
+    Grid rotate(const int rotation, GridArena &arena) const;
     Cell &operator()(const int x, const int y);
     const Cell &operator()(const int x, const int y) const;
     friend std::ostream &operator<<(std::ostream &os, const Grid &grid);
     // How to draw an owl:
     //      Step 1. Draw a circle.
     //      Step 2. Draw the rest of the owl.
+};
+
+/**
+ * Declare the structure of the GridArena class, a pool of reusable cell buffers.
+ *
+ * Pipelines that crop, rotate, and merge thousands of transient grids per frame
+ * pay an allocate/free cycle for every temporary, which serializes worker
+ * threads on the allocator. The arena keeps the buffers of released grids and
+ * hands them back out to the arena-aware crop/rotate overloads, so a steady
+ * state pipeline stops touching the allocator entirely. Each worker thread
+ * should own its own arena, the class is deliberately unsynchronized.
+ */
+class GridArena
+{
+private:
+    std::vector<std::vector<Cell>> pool;
+
+public:
+    std::vector<Cell> acquire(const int cells);
+    void release(Grid &&grid);
+    int get_pooled_buffers() const;
+};
+
+/**
+ * Declare the structure of the GridView class, a non-owning read-only view of a Grid.
+ *
+ * A GridView is a single pointer, so observing a grid through one never copies
+ * or allocates - unlike taking a Grid by value. Views stay valid only as long
+ * as the grid they observe.
+ */
+class GridView
+{
+private:
+    const Grid *grid;
+
+public:
+    GridView(const Grid &grid);
+    int get_width() const;
+    int get_height() const;
+    int get_total_cells() const;
+    int get_alive_cells() const;
+    int get_dead_cells() const;
+    const Cell get(const int x, const int y) const;
+    const Cell *row_data(const int y) const;
+    bool is_packed() const;
+    Grid crop(const int x0, const int y0, const int x1, const int y1) const;
+    friend std::ostream &operator<<(std::ostream &os, const GridView &view);
 };
\ No newline at end of file
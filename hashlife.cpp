@@ -0,0 +1,535 @@
+/**
+ * Implements a class implementing the Hashlife algorithm for simulating a cellular automaton.
+ *      - The universe is a quadtree: a level k node is a square of 2^k cells made of
+ *        four level k-1 children, down to level 0 nodes that are single cells.
+ *      - Nodes are hash-consed: joining the same four children always returns the same
+ *        canonical node, so identical regions of the universe share storage and node
+ *        pointer identity doubles as region equality.
+ *      - Stepping is memoized: successor(node, speed) computes the centre of a node
+ *        advanced 2^speed generations, and the result is cached by (node, speed), so
+ *        any region of spacetime is only ever computed once. Repetitive patterns like
+ *        guns and oscillators collapse almost entirely into cache hits, which is what
+ *        makes jumps of billions of generations feasible.
+ *      - The universe is unbounded; the quadtree grows as patterns spread. Coordinates
+ *        keep the frame of the Grid the engine was constructed from, so render windows
+ *        line up with the original pattern (negative coordinates are valid, patterns
+ *        may grow up and left).
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "hashlife.h"
+#include <stdexcept>
+
+/**
+ * HashLife::NodeKeyHash::operator()(key)
+ *
+ * Hash the four child pointers of a node. Children are canonical, so the
+ * pointers fully identify the node being looked up.
+ *
+ * @param key
+ *      The four child pointers.
+ *
+ * @return
+ *      A hash of the four pointers.
+ */
+std::size_t HashLife::NodeKeyHash::operator()(const NodeKey &key) const
+{
+    std::size_t hash = std::size_t(key.nw);
+    hash = hash * 31 + std::size_t(key.ne);
+    hash = hash * 31 + std::size_t(key.sw);
+    hash = hash * 31 + std::size_t(key.se);
+    return hash;
+}
+
+/**
+ * HashLife::StepKeyHash::operator()(key)
+ *
+ * Hash a node pointer and step speed for the memoized results table.
+ *
+ * @param key
+ *      The node and speed pair.
+ *
+ * @return
+ *      A hash of the pair.
+ */
+std::size_t HashLife::StepKeyHash::operator()(const StepKey &key) const
+{
+    return std::size_t(key.node) * 31 + std::size_t(key.speed);
+}
+
+/**
+ * HashLife::HashLife(initial_state)
+ *
+ * Construct a memoized quadtree universe from an existing grid.
+ * The grid's top left cell sits at coordinate (0, 0) of the universe,
+ * so Zoo::load_ascii output feeds straight in and render windows use
+ * the same frame as the original pattern.
+ *
+ * @example
+ *
+ *      // Load a pattern and jump it forward a billion generations
+ *      HashLife universe(Zoo::load_ascii("gun.gol"));
+ *      universe.advance(1000000000LL);
+ *
+ * @param initial_state
+ *      The starting state of the universe.
+ */
+HashLife::HashLife(const Grid &initial_state) : origin_x(0), origin_y(0), generation(0)
+{
+    //the two level 0 singletons every other node is built from
+    nodes.push_back(std::unique_ptr<Node>(new Node{nullptr, nullptr, nullptr, nullptr, 0, 0}));
+    dead = nodes.back().get();
+    nodes.push_back(std::unique_ptr<Node>(new Node{nullptr, nullptr, nullptr, nullptr, 1, 0}));
+    alive = nodes.back().get();
+    empties.push_back(dead);
+
+    //pick the smallest square that holds the whole grid
+    int level = 1;
+    while ((1LL << level) < initial_state.get_width() || (1LL << level) < initial_state.get_height())
+    {
+        level++;
+    }
+    root = empty(level);
+    for (int y = 0; y < initial_state.get_height(); y++)
+    {
+        for (int x = 0; x < initial_state.get_width(); x++)
+        {
+            if (initial_state.get(x, y) == Cell::ALIVE)
+            {
+                root = set_cell(root, x, y);
+            }
+        }
+    }
+}
+
+/**
+ * HashLife::join(nw, ne, sw, se)
+ *
+ * Private helper function returning the canonical node with the given four
+ * children, creating it on first use. This is the only place nodes above
+ * level 0 are made, which is what keeps the quadtree hash-consed.
+ *
+ * @param nw, ne, sw, se
+ *      The four children, all of the same level.
+ *
+ * @return
+ *      The canonical node one level above the children.
+ */
+const HashLife::Node *HashLife::join(const Node *nw, const Node *ne, const Node *sw, const Node *se)
+{
+    NodeKey key{nw, ne, sw, se};
+    auto found = table.find(key);
+    if (found != table.end())
+    {
+        return found->second;
+    }
+    long long population = nw->population + ne->population + sw->population + se->population;
+    nodes.push_back(std::unique_ptr<Node>(new Node{nw, ne, sw, se, population, nw->level + 1}));
+    table[key] = nodes.back().get();
+    return nodes.back().get();
+}
+
+/**
+ * HashLife::empty(level)
+ *
+ * Private helper function returning the canonical all-dead node of a level.
+ * Empty space of any size is a single shared node per level.
+ *
+ * @param level
+ *      The level of the empty node wanted.
+ *
+ * @return
+ *      The canonical empty node of that level.
+ */
+const HashLife::Node *HashLife::empty(const int level)
+{
+    while (int(empties.size()) <= level)
+    {
+        const Node *e = empties.back();
+        empties.push_back(join(e, e, e, e));
+    }
+    return empties[level];
+}
+
+/**
+ * HashLife::centre(node)
+ *
+ * Private helper function extracting the centred child one level down,
+ * the square covering the middle half of the node.
+ *
+ * @param node
+ *      The node to take the centre of, level 2 or above.
+ *
+ * @return
+ *      The centre node one level below.
+ */
+const HashLife::Node *HashLife::centre(const Node *node)
+{
+    return join(node->nw->se, node->ne->sw, node->sw->ne, node->se->nw);
+}
+
+/**
+ * HashLife::life_4x4(node)
+ *
+ * Private helper function advancing a level 2 node (a 4x4 square) one
+ * generation by directly applying the rules of Conway's Game of Life,
+ * returning the centre 2x2. This is the base case every memoized step
+ * bottoms out in.
+ *
+ * @param node
+ *      The level 2 node to advance.
+ *
+ * @return
+ *      The centre level 1 node one generation forward.
+ */
+const HashLife::Node *HashLife::life_4x4(const Node *node)
+{
+    //unpack the 16 cells
+    int cells[4][4];
+    const Node *quads[2][2] = {{node->nw, node->ne}, {node->sw, node->se}};
+    for (int qy = 0; qy < 2; qy++)
+    {
+        for (int qx = 0; qx < 2; qx++)
+        {
+            const Node *quad = quads[qy][qx];
+            cells[qy * 2 + 0][qx * 2 + 0] = int(quad->nw->population);
+            cells[qy * 2 + 0][qx * 2 + 1] = int(quad->ne->population);
+            cells[qy * 2 + 1][qx * 2 + 0] = int(quad->sw->population);
+            cells[qy * 2 + 1][qx * 2 + 1] = int(quad->se->population);
+        }
+    }
+    //step the centre four cells
+    const Node *result[2][2];
+    for (int y = 1; y <= 2; y++)
+    {
+        for (int x = 1; x <= 2; x++)
+        {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    n += cells[y + dy][x + dx];
+                }
+            }
+            //the neighbourhood sum includes the centre cell, remove it
+            n -= cells[y][x];
+            result[y - 1][x - 1] = (n == 3 || (n == 2 && cells[y][x])) ? alive : dead;
+        }
+    }
+    return join(result[0][0], result[0][1], result[1][0], result[1][1]);
+}
+
+/**
+ * HashLife::successor(node, speed)
+ *
+ * Private helper function computing the centre of a node advanced forward
+ * 2^speed generations, the heart of Hashlife. Results are memoized by
+ * (node, speed), so a region of spacetime is only ever computed once no
+ * matter how often the pattern repeats it.
+ *
+ * The nine overlapping half-size subsquares are each advanced recursively;
+ * at full speed (speed == level - 2) a second recursive round advances the
+ * results again, doubling the jump per level, while at lower speeds the
+ * centres are just reassembled.
+ *
+ * @param node
+ *      The node to advance, level 2 or above.
+ *
+ * @param speed
+ *      The log2 of the generations to advance, clamped to level - 2.
+ *
+ * @return
+ *      The centre node one level below, 2^speed generations forward.
+ */
+const HashLife::Node *HashLife::successor(const Node *node, const int speed)
+{
+    if (node->population == 0)
+    {
+        //empty space stays empty
+        return empty(node->level - 1);
+    }
+    if (node->level == 2)
+    {
+        return life_4x4(node);
+    }
+    const int clamped = speed < node->level - 2 ? speed : node->level - 2;
+    StepKey key{node, clamped};
+    auto found = results.find(key);
+    if (found != results.end())
+    {
+        return found->second;
+    }
+
+    //the nine overlapping half-size subsquares of the node
+    const Node *c1 = successor(node->nw, clamped);
+    const Node *c2 = successor(join(node->nw->ne, node->ne->nw, node->nw->se, node->ne->sw), clamped);
+    const Node *c3 = successor(node->ne, clamped);
+    const Node *c4 = successor(join(node->nw->sw, node->nw->se, node->sw->nw, node->sw->ne), clamped);
+    const Node *c5 = successor(centre(node), clamped);
+    const Node *c6 = successor(join(node->ne->sw, node->ne->se, node->se->nw, node->se->ne), clamped);
+    const Node *c7 = successor(node->sw, clamped);
+    const Node *c8 = successor(join(node->sw->ne, node->se->nw, node->sw->se, node->se->sw), clamped);
+    const Node *c9 = successor(node->se, clamped);
+
+    const Node *result;
+    if (clamped < node->level - 2)
+    {
+        //below full speed the nine pieces are already far enough forward,
+        //reassemble their centres into the result
+        result = join(join(c1->se, c2->sw, c4->ne, c5->nw),
+                      join(c2->se, c3->sw, c5->ne, c6->nw),
+                      join(c4->se, c5->sw, c7->ne, c8->nw),
+                      join(c5->se, c6->sw, c8->ne, c9->nw));
+    }
+    else
+    {
+        //at full speed advance the reassembled quadrants a second time,
+        //doubling the jump at every level of the tree
+        result = join(successor(join(c1, c2, c4, c5), clamped),
+                      successor(join(c2, c3, c5, c6), clamped),
+                      successor(join(c4, c5, c7, c8), clamped),
+                      successor(join(c5, c6, c8, c9), clamped));
+    }
+    results[key] = result;
+    return result;
+}
+
+/**
+ * HashLife::set_cell(node, x, y)
+ *
+ * Private helper function returning the canonical node equal to the given
+ * node with the cell at (x, y) set alive. Coordinates are relative to the
+ * node's top left corner.
+ *
+ * @param node
+ *      The node to set a cell in.
+ *
+ * @param x
+ *      The x coordinate of the cell within the node.
+ *
+ * @param y
+ *      The y coordinate of the cell within the node.
+ *
+ * @return
+ *      The canonical node with the cell alive.
+ */
+const HashLife::Node *HashLife::set_cell(const Node *node, const long long x, const long long y)
+{
+    if (node->level == 0)
+    {
+        return alive;
+    }
+    const long long half = 1LL << (node->level - 1);
+    if (y < half)
+    {
+        if (x < half)
+        {
+            return join(set_cell(node->nw, x, y), node->ne, node->sw, node->se);
+        }
+        return join(node->nw, set_cell(node->ne, x - half, y), node->sw, node->se);
+    }
+    if (x < half)
+    {
+        return join(node->nw, node->ne, set_cell(node->sw, x, y - half), node->se);
+    }
+    return join(node->nw, node->ne, node->sw, set_cell(node->se, x - half, y - half));
+}
+
+/**
+ * HashLife::expand()
+ *
+ * Private helper function growing the universe by one level, keeping the
+ * existing content centred inside a border of empty space. The origin
+ * shifts up and left by a quarter of the new size so world coordinates
+ * are unchanged.
+ */
+void HashLife::expand()
+{
+    const Node *border = empty(root->level - 1);
+    root = join(join(border, border, border, root->nw),
+                join(border, border, root->ne, border),
+                join(border, root->sw, border, border),
+                join(root->se, border, border, border));
+    origin_x -= 1LL << (root->level - 2);
+    origin_y -= 1LL << (root->level - 2);
+}
+
+/**
+ * HashLife::pad(speed)
+ *
+ * Private helper function expanding the universe until a 2^speed step is
+ * safe: the root must be deep enough for the step, and every live cell
+ * must sit in the central quarter of the root so nothing can reach the
+ * edge - or fall outside the returned centre - during the jump.
+ *
+ * @param speed
+ *      The log2 of the generations the next step will advance.
+ */
+void HashLife::pad(const int speed)
+{
+    while (root->level < 3 || root->level < speed + 2 ||
+           centre(centre(root))->population != root->population)
+    {
+        expand();
+    }
+}
+
+/**
+ * HashLife::get_generation()
+ *
+ * Gets the number of generations the universe has been advanced.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The current generation number.
+ */
+long long HashLife::get_generation() const
+{
+    return generation;
+}
+
+/**
+ * HashLife::get_population()
+ *
+ * Gets the number of alive cells in the universe. The count is stored on
+ * every node, so this is O(1) regardless of universe size.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The number of alive cells.
+ */
+long long HashLife::get_population() const
+{
+    return root->population;
+}
+
+/**
+ * HashLife::advance(steps)
+ *
+ * Advance the universe forward in time.
+ *
+ * The step count is decomposed into powers of two and each power is taken
+ * as one memoized jump, so advancing by 2^40 generations is 40 jumps, not
+ * a trillion individual steps. Repetitive patterns hit the result cache
+ * and advance almost for free.
+ *
+ * @example
+ *
+ *      // What does the r-pentomino look like after 2^40 generations?
+ *      HashLife universe(Zoo::r_pentomino());
+ *      universe.advance(1LL << 40);
+ *
+ * @param steps
+ *      The number of generations to advance the universe forward.
+ */
+void HashLife::advance(const long long steps)
+{
+    long long remaining = steps;
+    int speed = 0;
+    while (remaining > 0)
+    {
+        if (remaining & 1)
+        {
+            pad(speed);
+            root = successor(root, speed);
+            //the result is the centre of the old root, half its size
+            origin_x += 1LL << (root->level - 1);
+            origin_y += 1LL << (root->level - 1);
+            generation += 1LL << speed;
+        }
+        remaining >>= 1;
+        speed++;
+    }
+}
+
+/**
+ * HashLife::fill(node, x, y, x0, y0, x1, y1, grid)
+ *
+ * Private helper function copying the alive cells of a node that fall in
+ * the window [x0, x1) by [y0, y1) into a grid. Empty nodes and nodes that
+ * miss the window are skipped whole, so rendering costs O(live cells in
+ * the window) rather than O(universe size).
+ *
+ * @param node
+ *      The node to copy from.
+ *
+ * @param x
+ *      The world x coordinate of the node's top left corner.
+ *
+ * @param y
+ *      The world y coordinate of the node's top left corner.
+ *
+ * @param x0, y0, x1, y1
+ *      The world coordinate window being rendered.
+ *
+ * @param grid
+ *      The grid to set alive cells in, sized to the window.
+ */
+void HashLife::fill(const Node *node, const long long x, const long long y,
+                    const long long x0, const long long y0, const long long x1, const long long y1,
+                    Grid &grid) const
+{
+    const long long size = 1LL << node->level;
+    if (node->population == 0 || x >= x1 || y >= y1 || x + size <= x0 || y + size <= y0)
+    {
+        return;
+    }
+    if (node->level == 0)
+    {
+        grid.set(int(x - x0), int(y - y0), Cell::ALIVE);
+        return;
+    }
+    const long long half = size / 2;
+    fill(node->nw, x, y, x0, y0, x1, y1, grid);
+    fill(node->ne, x + half, y, x0, y0, x1, y1, grid);
+    fill(node->sw, x, y + half, x0, y0, x1, y1, grid);
+    fill(node->se, x + half, y + half, x0, y0, x1, y1, grid);
+}
+
+/**
+ * HashLife::render(x0, y0, x1, y1)
+ *
+ * Render a window of the universe into a dense Grid, following the same
+ * [x0, x1) by [y0, y1) rectangle convention as Grid::crop. The window uses
+ * the coordinate frame of the grid the universe was constructed from, and
+ * may extend into negative coordinates since patterns grow in every
+ * direction. The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Look at the original pattern's bounding box deep in the future
+ *      Grid window = universe.render(0, 0, 100, 100);
+ *
+ * @param x0
+ *      Left coordinate of the render window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the render window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the render window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the render window on y-axis (1 greater than the largest index).
+ *
+ * @return
+ *      A new grid of the window size containing the cells of the universe within it.
+ *
+ * @throws
+ *      std::exception or sub-class if the window has a negative size.
+ */
+Grid HashLife::render(const long long x0, const long long y0, const long long x1, const long long y1) const
+{
+    if (x0 > x1 || y0 > y1)
+    {
+        throw std::length_error("Render window has a negative size");
+    }
+    Grid grid(int(x1 - x0), int(y1 - y0));
+    fill(root, origin_x, origin_y, x0, y0, x1, y1, grid);
+    return grid;
+}
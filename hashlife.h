@@ -0,0 +1,93 @@
+/**
+ * Declares a class implementing the Hashlife algorithm for simulating a cellular automaton.
+ * Rich documentation for the api and behaviour the HashLife class can be found in hashlife.cpp.
+ *
+ * HashLife represents the universe as a quadtree of hash-consed nodes, so identical
+ * regions of space are stored once, and memoizes the future of every node it has
+ * ever stepped, so identical regions of spacetime are computed once. This lets it
+ * jump repetitive patterns forward by astronomical numbers of generations - advance
+ * takes a 64 bit step count where World::advance walks one generation at a time.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include "grid.h"
+#include <memory>
+#include <unordered_map>
+
+/**
+ * Declare the structure of the HashLife class for representing a memoized quadtree universe.
+ *
+ * The universe is a square of 2^level cells. Nodes are canonical: joining the same
+ * four children twice yields the same node pointer, which is what makes memoizing
+ * step results by node identity sound.
+ */
+class HashLife
+{
+private:
+    struct Node
+    {
+        const Node *nw, *ne, *sw, *se;
+        long long population;
+        int level;
+    };
+    struct NodeKey
+    {
+        const Node *nw, *ne, *sw, *se;
+        bool operator==(const NodeKey &other) const
+        {
+            return nw == other.nw && ne == other.ne && sw == other.sw && se == other.se;
+        }
+    };
+    struct NodeKeyHash
+    {
+        std::size_t operator()(const NodeKey &key) const;
+    };
+    struct StepKey
+    {
+        const Node *node;
+        int speed;
+        bool operator==(const StepKey &other) const
+        {
+            return node == other.node && speed == other.speed;
+        }
+    };
+    struct StepKeyHash
+    {
+        std::size_t operator()(const StepKey &key) const;
+    };
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::unordered_map<NodeKey, const Node *, NodeKeyHash> table;
+    std::unordered_map<StepKey, const Node *, StepKeyHash> results;
+    std::vector<const Node *> empties;
+    const Node *dead;
+    const Node *alive;
+    const Node *root;
+    long long origin_x;
+    long long origin_y;
+    long long generation;
+
+    const Node *join(const Node *nw, const Node *ne, const Node *sw, const Node *se);
+    const Node *empty(const int level);
+    const Node *centre(const Node *node);
+    const Node *life_4x4(const Node *node);
+    const Node *successor(const Node *node, const int speed);
+    const Node *set_cell(const Node *node, const long long x, const long long y);
+    void expand();
+    void pad(const int speed);
+    void fill(const Node *node, const long long x, const long long y,
+              const long long x0, const long long y0, const long long x1, const long long y1,
+              Grid &grid) const;
+
+public:
+    HashLife(const Grid &initial_state);
+    long long get_generation() const;
+    long long get_population() const;
+    void advance(const long long steps);
+    Grid render(const long long x0, const long long y0, const long long x1, const long long y1) const;
+};
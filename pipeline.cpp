@@ -0,0 +1,201 @@
+/**
+ * Implements a class overlapping simulation, rendering, and file output.
+ *      - The producer (the step loop) submits snapshots of the world into a
+ *        bounded ring; submit only blocks when the ring is full, which is the
+ *        backpressure that keeps memory use at a few frames.
+ *      - A render stage prints each snapshot to the console through the fast
+ *        Renderer, and a save stage writes each snapshot to the output file,
+ *        each on its own thread - so with three-deep buffering the step loop
+ *        stops paying render and i/o time on the critical path entirely.
+ *      - Snapshots are shared between the two stages, one copy per frame.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "pipeline.h"
+#include "zoo.h"
+#include <iostream>
+
+/**
+ * GenerationPipeline::GenerationPipeline(render, diff, save_path, depth)
+ *
+ * Construct a pipeline and start the consumer stages it needs: a render
+ * stage when render is true, a save stage when save_path is not empty.
+ *
+ * @example
+ *
+ *      // Overlap stepping with printing every frame and saving snapshots
+ *      GenerationPipeline pipeline(true, false, "out.gol");
+ *      for (int step = 0; step < steps; step++) {
+ *          world.step();
+ *          pipeline.submit(world.get_state(), step + 1, steps);
+ *      }
+ *      pipeline.finish();
+ *
+ * @param render
+ *      Whether snapshots should be printed to the console.
+ *
+ * @param diff
+ *      Whether the console stage should redraw only changed rows.
+ *
+ * @param save_path
+ *      The file snapshots are written to, empty for no save stage.
+ *
+ * @param depth
+ *      Optional parameter. How many frames may be in flight per stage before
+ *      submit blocks the producer. Defaults to 3.
+ */
+GenerationPipeline::GenerationPipeline(const bool render, const bool diff,
+                                       const std::string &_save_path, const int _depth)
+    : depth(_depth < 1 ? 1 : _depth), rendering(render), diff_mode(diff), save_path(_save_path), renderer(diff)
+{
+    if (rendering)
+    {
+        render_thread = std::thread(&GenerationPipeline::render_frames, this);
+    }
+    if (!save_path.empty())
+    {
+        save_thread = std::thread(&GenerationPipeline::save_frames, this);
+    }
+}
+
+/**
+ * GenerationPipeline::~GenerationPipeline()
+ *
+ * Destruct the pipeline, draining and joining the stages.
+ */
+GenerationPipeline::~GenerationPipeline()
+{
+    finish();
+}
+
+/**
+ * GenerationPipeline::submit(snapshot, step, total)
+ *
+ * Hand one snapshot of the world to the consumer stages. The snapshot is
+ * shared by both stages without further copies. Blocks only when a stage
+ * is more than depth frames behind, which is the backpressure bounding
+ * memory use.
+ *
+ * @param snapshot
+ *      The state to render and/or save, moved from.
+ *
+ * @param step
+ *      The step number the snapshot belongs to, for the console header.
+ *
+ * @param total
+ *      The total number of steps of the run, for the console header.
+ */
+void GenerationPipeline::submit(Grid &&snapshot, const int step, const int total)
+{
+    std::shared_ptr<const Grid> shared(new Grid(std::move(snapshot)));
+    Frame frame{shared, step, total};
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    space_available.wait(lock, [this] {
+        return (int(render_queue.size()) < depth || !rendering) &&
+               (int(save_queue.size()) < depth || save_path.empty());
+    });
+    if (rendering)
+    {
+        render_queue.push_back(frame);
+    }
+    if (!save_path.empty())
+    {
+        save_queue.push_back(frame);
+    }
+    frames_available.notify_all();
+}
+
+/**
+ * GenerationPipeline::finish()
+ *
+ * Block until every submitted frame has been rendered and saved, then stop
+ * the stages. Called by the destructor, callers that want the final frame
+ * on screen or on disk before printing their own output call it directly.
+ */
+void GenerationPipeline::finish()
+{
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        done = true;
+        frames_available.notify_all();
+    }
+    if (render_thread.joinable())
+    {
+        render_thread.join();
+    }
+    if (save_thread.joinable())
+    {
+        save_thread.join();
+    }
+}
+
+/**
+ * GenerationPipeline::render_frames()
+ *
+ * Private helper function running the console stage: takes frames from the
+ * render ring in order and prints them through the fast renderer until the
+ * pipeline is finished and drained.
+ */
+void GenerationPipeline::render_frames()
+{
+    while (true)
+    {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            frames_available.wait(lock, [this] { return !render_queue.empty() || done; });
+            if (render_queue.empty())
+            {
+                return;
+            }
+            frame = render_queue.front();
+            render_queue.pop_front();
+            space_available.notify_all();
+        }
+        //in diff mode the frame is redrawn in place, a header would break the cursor math
+        if (!diff_mode)
+        {
+            std::cout << "Step " << frame.step << " of " << frame.total << std::endl;
+        }
+        renderer.render(std::cout, GridView(*frame.grid));
+    }
+}
+
+/**
+ * GenerationPipeline::save_frames()
+ *
+ * Private helper function running the file stage: writes each frame over
+ * the output file in order, so the file always holds the newest snapshot
+ * that has fully finished writing, until the pipeline is finished and
+ * drained.
+ */
+void GenerationPipeline::save_frames()
+{
+    while (true)
+    {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            frames_available.wait(lock, [this] { return !save_queue.empty() || done; });
+            if (save_queue.empty())
+            {
+                return;
+            }
+            frame = save_queue.front();
+            save_queue.pop_front();
+            space_available.notify_all();
+        }
+        try
+        {
+            Zoo::save_ascii(save_path, GridView(*frame.grid));
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << ex.what() << std::endl;
+        }
+    }
+}
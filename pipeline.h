@@ -0,0 +1,59 @@
+/**
+ * Declares a class overlapping simulation, rendering, and file output.
+ * Rich documentation for the api and behaviour the GenerationPipeline class can be found in pipeline.cpp.
+ *
+ * The sequential main loop pays for stepping, printing, and saving one after
+ * the other. The pipeline turns the latter two into consumer stages fed by a
+ * small bounded ring of state snapshots, so generation N+1 computes while
+ * N renders and an earlier snapshot is still being written to disk.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include "grid.h"
+#include "renderer.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Declare the structure of the GenerationPipeline class for overlapped output.
+ */
+class GenerationPipeline
+{
+private:
+    struct Frame
+    {
+        std::shared_ptr<const Grid> grid;
+        int step;
+        int total;
+    };
+    int depth;
+    bool rendering;
+    bool diff_mode;
+    std::string save_path;
+    Renderer renderer;
+    std::deque<Frame> render_queue;
+    std::deque<Frame> save_queue;
+    std::mutex queue_mutex;
+    std::condition_variable space_available;
+    std::condition_variable frames_available;
+    bool done = false;
+    std::thread render_thread;
+    std::thread save_thread;
+    void render_frames();
+    void save_frames();
+
+public:
+    GenerationPipeline(const bool render, const bool diff, const std::string &save_path, const int depth = 3);
+    ~GenerationPipeline();
+    void submit(Grid &&snapshot, const int step, const int total);
+    void finish();
+};
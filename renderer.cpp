@@ -0,0 +1,150 @@
+/**
+ * Implements a class for rendering grids to a console quickly.
+ *      - Frames are assembled into one reused buffer and written with a single
+ *        bulk write, instead of streaming cell by cell through std::ostream.
+ *      - Rows of a byte-per-cell grid are copied straight out of the grid
+ *        buffer, the Cell values are already the ' ' and '#' characters that
+ *        the ascii rendering uses. Bit-packed grids unpack cell by cell.
+ *      - In diff mode only the rows that changed since the previous frame are
+ *        redrawn, using cursor movement escape codes, so a mostly quiescent
+ *        world costs almost nothing to keep on screen.
+ *      - The frame layout matches the Grid ostream operator: a border of
+ *        + - and | characters around the cells.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "renderer.h"
+#include <ostream>
+
+/**
+ * Renderer::Renderer(diff_mode)
+ *
+ * Construct a renderer, optionally in diff mode.
+ *
+ * @example
+ *
+ *      // Live view of a world, redrawing only what changed
+ *      Renderer renderer(true);
+ *      for (int i = 0; i < 1000; i++) {
+ *          world.step();
+ *          renderer.render(std::cout, world.view());
+ *      }
+ *
+ * @param diff_mode
+ *      Optional parameter. If true then frames after the first only redraw
+ *      changed rows in place using cursor movement. Defaults to false.
+ */
+Renderer::Renderer(const bool diff_mode) : diff(diff_mode)
+{
+}
+
+/**
+ * Renderer::build_row(out, view, y)
+ *
+ * Private helper function appending one bordered row of the grid to the
+ * buffer. Byte-per-cell rows are appended with one bulk copy, the cell
+ * values already being the rendered characters; bit-packed rows unpack.
+ *
+ * @param out
+ *      The buffer to append to.
+ *
+ * @param view
+ *      The grid being rendered.
+ *
+ * @param y
+ *      The row to append.
+ */
+void Renderer::build_row(std::string &out, const GridView &view, const int y) const
+{
+    out += '|';
+    if (!view.is_packed())
+    {
+        out.append((const char *)view.row_data(y), view.get_width());
+    }
+    else
+    {
+        for (int x = 0; x < view.get_width(); x++)
+        {
+            out += char(view.get(x, y));
+        }
+    }
+    out += '|';
+}
+
+/**
+ * Renderer::render(os, view)
+ *
+ * Render one frame of the grid to the stream.
+ *
+ * The full frame - border, rows, border - is assembled in the reused
+ * internal buffer and written with a single call, so the stream overhead
+ * per frame is constant instead of per cell. In diff mode the first frame
+ * and any frame after a resize draw fully; later frames move the cursor
+ * back over the previous frame and rewrite only the rows that changed,
+ * skipping the rest with a cursor-down movement.
+ *
+ * @param os
+ *      The output stream, typically std::cout attached to a terminal for diff mode.
+ *
+ * @param view
+ *      The grid to render.
+ */
+void Renderer::render(std::ostream &os, const GridView &view)
+{
+    const int w = view.get_width();
+    const int h = view.get_height();
+
+    //rows of the new frame, reused for the next diff
+    std::vector<std::string> rows(h);
+    for (int y = 0; y < h; y++)
+    {
+        build_row(rows[y], view, y);
+    }
+
+    frame.clear();
+    const bool full = !diff || int(last_rows.size()) != h ||
+                      (h > 0 && int(last_rows[0].size()) != w + 2);
+    if (full)
+    {
+        //border, every row, border, one write
+        frame += '+';
+        frame.append(w, '-');
+        frame += "+\n";
+        for (int y = 0; y < h; y++)
+        {
+            frame += rows[y];
+            frame += '\n';
+        }
+        frame += '+';
+        frame.append(w, '-');
+        frame += "+\n";
+    }
+    else
+    {
+        //move back to the first cell row of the previous frame, then redraw
+        //changed rows and hop over unchanged ones
+        frame += "\x1b[" + std::to_string(h + 1) + "A";
+        for (int y = 0; y < h; y++)
+        {
+            if (rows[y] != last_rows[y])
+            {
+                frame += '\r';
+                frame += rows[y];
+                frame += "\x1b[1B";
+            }
+            else
+            {
+                frame += "\x1b[1B";
+            }
+        }
+        //land back under the bottom border
+        frame += "\r\x1b[1B";
+    }
+    os.write(frame.data(), frame.size());
+    os.flush();
+    last_rows = std::move(rows);
+}
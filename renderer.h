@@ -0,0 +1,36 @@
+/**
+ * Declares a class for rendering grids to a console quickly.
+ * Rich documentation for the api and behaviour the Renderer class can be found in renderer.cpp.
+ *
+ * The Grid ostream operator streams one character at a time, which is slower
+ * than stepping once frames are printed every generation. The Renderer builds
+ * each frame into one preallocated buffer - rows of a byte-per-cell grid are
+ * memcpy'd straight out of the grid - and emits it with a single bulk write,
+ * with an optional diff mode that only redraws the rows that changed using
+ * terminal cursor movement.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include "grid.h"
+#include <string>
+
+/**
+ * Declare the structure of the Renderer class for fast console output of grids.
+ */
+class Renderer
+{
+private:
+    bool diff;
+    std::string frame;
+    std::vector<std::string> last_rows;
+    void build_row(std::string &out, const GridView &view, const int y) const;
+
+public:
+    Renderer(const bool diff_mode = false);
+    void render(std::ostream &os, const GridView &view);
+};
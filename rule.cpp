@@ -0,0 +1,161 @@
+/**
+ * Implements a class representing a life-like cellular automaton rule.
+ *      - Rules are described by B/S rulestrings: "B3/S23" is Conway's Game of
+ *        Life, a dead cell becomes alive with exactly 3 alive neighbours and an
+ *        alive cell survives with 2 or 3. "B36/S23" is HighLife, and any other
+ *        combination of birth and survival counts parses the same way.
+ *      - The rulestring is compiled at construction into an 18 entry table
+ *        indexed by (neighbour count, current state), so applying the rule in
+ *        the step inner loop is a single table read with no data-dependent
+ *        branches.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "rule.h"
+#include <stdexcept>
+
+/**
+ * Rule::Rule()
+ *
+ * Construct the default rule, Conway's Game of Life "B3/S23".
+ *
+ * @example
+ *
+ *      // The rule every World starts with
+ *      Rule life;
+ *
+ */
+Rule::Rule() : Rule(std::string("B3/S23"))
+{
+}
+
+/**
+ * Rule::Rule(rulestring)
+ *
+ * Construct a rule from a B/S rulestring, compiling it into the lookup table.
+ *
+ * @example
+ *
+ *      // HighLife: like Life but a dead cell is also born with 6 neighbours
+ *      Rule highlife("B36/S23");
+ *
+ * @param rulestring
+ *      The rule in B/S notation: the letter B followed by the neighbour counts
+ *      that make a dead cell alive, a slash, and the letter S followed by the
+ *      counts that keep an alive cell alive. Case insensitive.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the rulestring is not of that shape.
+ */
+Rule::Rule(const std::string &_rulestring) : rulestring(_rulestring)
+{
+    for (int i = 0; i < 18; i++)
+    {
+        table[i] = Cell::DEAD;
+    }
+    std::size_t slash = rulestring.find('/');
+    if (rulestring.empty() || slash == std::string::npos ||
+        (rulestring[0] != 'B' && rulestring[0] != 'b') ||
+        slash + 1 >= rulestring.size() ||
+        (rulestring[slash + 1] != 'S' && rulestring[slash + 1] != 's'))
+    {
+        throw std::runtime_error("Rulestring is not of the form B.../S...");
+    }
+    //birth counts light up the dead entries, survival counts the alive entries
+    for (std::size_t i = 1; i < slash; i++)
+    {
+        char c = rulestring[i];
+        if (c < '0' || c > '8')
+        {
+            throw std::runtime_error("Rulestring birth counts must be digits 0-8");
+        }
+        table[(c - '0') * 2 + 0] = Cell::ALIVE;
+    }
+    for (std::size_t i = slash + 2; i < rulestring.size(); i++)
+    {
+        char c = rulestring[i];
+        if (c < '0' || c > '8')
+        {
+            throw std::runtime_error("Rulestring survival counts must be digits 0-8");
+        }
+        table[(c - '0') * 2 + 1] = Cell::ALIVE;
+    }
+}
+
+/**
+ * Rule::get_rulestring()
+ *
+ * Gets the rulestring the rule was built from.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The rulestring.
+ */
+const std::string &Rule::get_rulestring() const
+{
+    return rulestring;
+}
+
+/**
+ * Rule::is_life()
+ *
+ * Returns whether this rule is exactly Conway's Game of Life, letting hot
+ * paths keep a specialised B3/S23 kernel and fall back to the table for
+ * every other rule.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      True if the table encodes B3/S23.
+ */
+bool Rule::is_life() const
+{
+    for (int n = 0; n <= 8; n++)
+    {
+        Cell born = (n == 3) ? Cell::ALIVE : Cell::DEAD;
+        Cell survive = (n == 2 || n == 3) ? Cell::ALIVE : Cell::DEAD;
+        if (table[n * 2 + 0] != born || table[n * 2 + 1] != survive)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Rule::next_cell(cur, n)
+ *
+ * Apply the rule to one cell: a single branch-free table read.
+ * The function should be callable from a constant context.
+ *
+ * @param cur
+ *      The current value of the cell.
+ *
+ * @param n
+ *      The number of alive neighbours of the cell, 0 to 8.
+ *
+ * @return
+ *      Returns the value of the cell in the next generation.
+ */
+Cell Rule::next_cell(const Cell cur, const int n) const
+{
+    return table[n * 2 + (cur == Cell::ALIVE ? 1 : 0)];
+}
+
+/**
+ * Rule::get_table()
+ *
+ * Gets the raw 18 entry lookup table, indexed by (n * 2 + alive), for hot
+ * loops that want to read it without a function call per cell.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      A read-only pointer to the 18 entry table.
+ */
+const Cell *Rule::get_table() const
+{
+    return table;
+}
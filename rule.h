@@ -0,0 +1,38 @@
+/**
+ * Declares a class representing a life-like cellular automaton rule.
+ * Rich documentation for the api and behaviour the Rule class can be found in rule.cpp.
+ *
+ * A rule is built once from a B/S rulestring like "B3/S23" (born with 3
+ * neighbours, survives with 2 or 3) and compiled into a small lookup table
+ * indexed by neighbour count and current state, so the step inner loop
+ * replaces its chain of data-dependent branches with one table read and
+ * variants like HighLife "B36/S23" come for free.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include "grid.h"
+#include <string>
+
+/**
+ * Declare the structure of the Rule class for representing a life-like rule.
+ */
+class Rule
+{
+private:
+    //18 entries: one Cell per (neighbour count 0..8, alive 0..1) pair
+    Cell table[18];
+    std::string rulestring;
+
+public:
+    Rule();
+    explicit Rule(const std::string &rulestring);
+    const std::string &get_rulestring() const;
+    bool is_life() const;
+    Cell next_cell(const Cell cur, const int n) const;
+    const Cell *get_table() const;
+};
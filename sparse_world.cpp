@@ -0,0 +1,467 @@
+/**
+ * Implements a class representing a sparse 2d grid world for simulating a cellular automaton.
+ *      - The universe is partitioned into fixed-size square tiles keyed by tile coordinate.
+ *      - Only tiles containing alive cells are stored, a missing tile is entirely dead.
+ *      - Stepping evaluates the stored tiles and the tiles bordering them, so activity
+ *        can spread into previously empty space, and retires tiles that end up dead.
+ *      - The api mirrors World, so a SparseWorld can be swapped in where the active
+ *        area is a small fraction of the universe.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "sparse_world.h"
+#include <stdexcept>
+
+/**
+ * SparseWorld::SparseWorld()
+ *
+ * Construct an empty sparse world of size 0x0.
+ *
+ * @example
+ *
+ *      // Make a 0x0 empty sparse world
+ *      SparseWorld world;
+ *
+ */
+SparseWorld::SparseWorld() : width(0), height(0)
+{
+}
+
+/**
+ * SparseWorld::SparseWorld(square_size)
+ *
+ * Construct a sparse world with the desired size filled with dead cells.
+ * No tiles are allocated until cells are set alive.
+ *
+ * @example
+ *
+ *      // Make a 16x16 sparse world
+ *      SparseWorld x(16);
+ *
+ * @param square_size
+ *      The edge size to use for the width and height of the world.
+ */
+SparseWorld::SparseWorld(const int square_size) : width(square_size), height(square_size)
+{
+}
+
+/**
+ * SparseWorld::SparseWorld(width, height)
+ *
+ * Construct a sparse world with the desired size filled with dead cells.
+ * No tiles are allocated until cells are set alive.
+ *
+ * @example
+ *
+ *      // Make a 16x9 sparse world
+ *      SparseWorld world(16, 9);
+ *
+ * @param width
+ *      The width of the world.
+ * @param height
+ *      The height of the world.
+ */
+SparseWorld::SparseWorld(const int _width, const int _height) : width(_width), height(_height)
+{
+}
+
+/**
+ * SparseWorld::SparseWorld(initial_state)
+ *
+ * Construct a sparse world using the size and values of an existing grid.
+ * Only the alive cells of the grid allocate tiles.
+ *
+ * @example
+ *
+ *      // Make a sparse world seeded with a glider
+ *      Grid grid(1024);
+ *      grid.merge(Zoo::glider(), 512, 512, true);
+ *      SparseWorld world(grid);
+ *
+ * @param initial_state
+ *      The state of the constructed world.
+ */
+SparseWorld::SparseWorld(const Grid &initial_state)
+    : width(initial_state.get_width()), height(initial_state.get_height())
+{
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            if (initial_state.get(x, y) == Cell::ALIVE)
+            {
+                set(x, y, Cell::ALIVE);
+            }
+        }
+    }
+}
+
+/**
+ * SparseWorld::get_width()
+ *
+ * Gets the current width of the world.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The width of the world.
+ */
+int SparseWorld::get_width() const
+{
+    return width;
+}
+
+/**
+ * SparseWorld::get_height()
+ *
+ * Gets the current height of the world.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The height of the world.
+ */
+int SparseWorld::get_height() const
+{
+    return height;
+}
+
+/**
+ * SparseWorld::get_total_cells()
+ *
+ * Gets the total number of cells in the world, stored or not.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The number of total cells.
+ */
+int SparseWorld::get_total_cells() const
+{
+    return width * height;
+}
+
+/**
+ * SparseWorld::get_alive_cells()
+ *
+ * Counts how many cells in the world are alive.
+ * Only the stored tiles need to be visited, a missing tile is entirely dead.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The number of alive cells.
+ */
+int SparseWorld::get_alive_cells() const
+{
+    int alive = 0;
+    for (const auto &tile : tiles)
+    {
+        for (const Cell cell : tile.second)
+        {
+            if (cell == Cell::ALIVE)
+            {
+                alive++;
+            }
+        }
+    }
+    return alive;
+}
+
+/**
+ * SparseWorld::get_dead_cells()
+ *
+ * Counts how many cells in the world are dead.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The number of dead cells.
+ */
+int SparseWorld::get_dead_cells() const
+{
+    return get_total_cells() - get_alive_cells();
+}
+
+/**
+ * SparseWorld::get_stored_tiles()
+ *
+ * Gets the number of tiles currently allocated.
+ * Useful for observing how far activity has spread through the universe.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The number of stored tiles.
+ */
+int SparseWorld::get_stored_tiles() const
+{
+    return tiles.size();
+}
+
+/**
+ * SparseWorld::get_state()
+ *
+ * Render the world into a dense Grid.
+ * Tiles that are not stored render as dead cells.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      A grid containing the current state of the world.
+ */
+const Grid SparseWorld::get_state() const
+{
+    Grid grid(width, height);
+    for (const auto &tile : tiles)
+    {
+        int x0 = tile.first.first * tile_size;
+        int y0 = tile.first.second * tile_size;
+        for (int i = 0; i < tile_size * tile_size; i++)
+        {
+            if (tile.second[i] == Cell::ALIVE)
+            {
+                grid.set(x0 + (i % tile_size), y0 + (i / tile_size), Cell::ALIVE);
+            }
+        }
+    }
+    return grid;
+}
+
+/**
+ * SparseWorld::get(x, y)
+ *
+ * Returns the value of the cell at the desired coordinate.
+ * The function should be callable from a constant context.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @return
+ *      The value of the desired cell.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the world.
+ */
+const Cell SparseWorld::get(const int x, const int y) const
+{
+    if (x < 0 || x >= width || y < 0 || y >= height)
+    {
+        throw std::length_error("X or Y out of range");
+    }
+    return get_cell(x, y, false);
+}
+
+/**
+ * SparseWorld::set(x, y, value)
+ *
+ * Overwrites the value at the desired coordinate.
+ * Setting a cell alive allocates its tile if it is not stored yet.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param value
+ *      The value to be written to the selected cell.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the world.
+ */
+void SparseWorld::set(const int x, const int y, const Cell value)
+{
+    if (x < 0 || x >= width || y < 0 || y >= height)
+    {
+        throw std::length_error("X or Y out of range");
+    }
+    std::pair<int, int> key(x / tile_size, y / tile_size);
+    auto found = tiles.find(key);
+    if (found == tiles.end())
+    {
+        if (value == Cell::DEAD)
+        {
+            //the tile is not stored so the cell is already dead
+            return;
+        }
+        found = tiles.emplace(key, std::vector<Cell>(tile_size * tile_size, Cell::DEAD)).first;
+    }
+    found->second[(y % tile_size) * tile_size + (x % tile_size)] = value;
+}
+
+/**
+ * SparseWorld::get_cell(x, y, toroidal)
+ *
+ * Private helper function reading a cell with bounds or wrap handling.
+ * Coordinates outside the universe are dead when toroidal = false and
+ * wrap to the opposite edge when toroidal = true. Cells of missing
+ * tiles are dead.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param toroidal
+ *      If true then out of bounds coordinates wrap to the opposite side of the universe.
+ *
+ * @return
+ *      The value of the desired cell.
+ */
+Cell SparseWorld::get_cell(const int x, const int y, const bool toroidal) const
+{
+    int curx = x;
+    int cury = y;
+    if (toroidal)
+    {
+        curx = (curx + width) % width;
+        cury = (cury + height) % height;
+    }
+    else if (curx < 0 || curx >= width || cury < 0 || cury >= height)
+    {
+        return Cell::DEAD;
+    }
+    auto found = tiles.find(std::pair<int, int>(curx / tile_size, cury / tile_size));
+    if (found == tiles.end())
+    {
+        return Cell::DEAD;
+    }
+    return found->second[(cury % tile_size) * tile_size + (curx % tile_size)];
+}
+
+/**
+ * SparseWorld::count_neighbours(x, y, toroidal)
+ *
+ * Private helper function to count the number of alive neighbours of a cell.
+ * Neighbours are considered within the 3x3 square centred around the cell at x,y.
+ * Ignore the centre coordinate, a cell is not its own neighbour.
+ *
+ * @param x
+ *      The x coordinate of the centre of the neighbourhood.
+ *
+ * @param y
+ *      The y coordinate of the centre of the neighbourhood.
+ *
+ * @param toroidal
+ *      If true then the step will consider the universe as a torus.
+ *
+ * @return
+ *      Returns the number of alive neighbours.
+ */
+int SparseWorld::count_neighbours(const int x, const int y, const bool toroidal) const
+{
+    int alive = 0;
+    for (int ypoint = y - 1; ypoint <= y + 1; ypoint++)
+    {
+        for (int xpoint = x - 1; xpoint <= x + 1; xpoint++)
+        {
+            if (get_cell(xpoint, ypoint, toroidal) == Cell::ALIVE)
+            {
+                alive++;
+            }
+        }
+    }
+    //Remove ourselves from the count!
+    if (get_cell(x, y, toroidal) == Cell::ALIVE)
+    {
+        alive--;
+    }
+    return alive;
+}
+
+/**
+ * SparseWorld::step(toroidal)
+ *
+ * Take one step in Conway's Game of Life.
+ *
+ * Only the stored tiles and the tiles bordering them can change, so the step
+ * visits just those tiles, builds their next state, and keeps only the tiles
+ * that contain alive cells. Everything else in the universe is dead and stays
+ * dead, making the cost of a step proportional to the active area.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the universe as a torus,
+ *      where the left edge wraps to the right edge and the top to the bottom. Defaults to false.
+ */
+void SparseWorld::step(const bool toroidal)
+{
+    //tile counts of the universe, the last tile in each axis may be partial
+    const int tiles_x = (width + tile_size - 1) / tile_size;
+    const int tiles_y = (height + tile_size - 1) / tile_size;
+
+    //collect the stored tiles and every tile bordering one, activity
+    //can only spread one cell per step so nothing else can change
+    std::map<std::pair<int, int>, bool> candidates;
+    for (const auto &tile : tiles)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                int tx = tile.first.first + dx;
+                int ty = tile.first.second + dy;
+                if (toroidal)
+                {
+                    tx = (tx + tiles_x) % tiles_x;
+                    ty = (ty + tiles_y) % tiles_y;
+                }
+                else if (tx < 0 || tx >= tiles_x || ty < 0 || ty >= tiles_y)
+                {
+                    continue;
+                }
+                candidates[std::pair<int, int>(tx, ty)] = true;
+            }
+        }
+    }
+
+    //build the next generation of every candidate tile, retiring dead ones
+    std::map<std::pair<int, int>, std::vector<Cell>> next;
+    for (const auto &candidate : candidates)
+    {
+        int x0 = candidate.first.first * tile_size;
+        int y0 = candidate.first.second * tile_size;
+        std::vector<Cell> tile(tile_size * tile_size, Cell::DEAD);
+        bool any_alive = false;
+        for (int y = y0; y < y0 + tile_size && y < height; y++)
+        {
+            for (int x = x0; x < x0 + tile_size && x < width; x++)
+            {
+                int n = count_neighbours(x, y, toroidal);
+                Cell cur = get_cell(x, y, false);
+                if (n == 3 || (n == 2 && cur == Cell::ALIVE))
+                {
+                    tile[(y - y0) * tile_size + (x - x0)] = Cell::ALIVE;
+                    any_alive = true;
+                }
+            }
+        }
+        if (any_alive)
+        {
+            next[candidate.first] = tile;
+        }
+    }
+    std::swap(tiles, next);
+}
+
+/**
+ * SparseWorld::advance(steps, toroidal)
+ *
+ * Advance multiple steps in the Game of Life.
+ * Should be implemented by invoking SparseWorld::step(toroidal).
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the universe as a torus,
+ *      where the left edge wraps to the right edge and the top to the bottom. Defaults to false.
+ */
+void SparseWorld::advance(const int steps, const bool toroidal)
+{
+    for (int i = 0; i < steps; i++)
+    {
+        step(toroidal);
+    }
+}
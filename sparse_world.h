@@ -0,0 +1,54 @@
+/**
+ * Declares a class representing a sparse 2d grid world for simulating a cellular automaton.
+ * Rich documentation for the api and behaviour the SparseWorld class can be found in sparse_world.cpp.
+ *
+ * A SparseWorld mirrors the World api but stores the universe as a map of fixed-size
+ * tiles, only keeping tiles that contain alive cells. Stepping visits the stored tiles
+ * and their direct neighbours instead of every cell of the universe, so the cost of a
+ * step scales with the active area rather than the total area.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include "grid.h"
+#include <map>
+#include <utility>
+
+/**
+ * Declare the structure of the SparseWorld class for representing a sparse 2d grid world.
+ *
+ * The universe is partitioned into tile_size x tile_size tiles keyed by their tile
+ * coordinate. A tile that is not stored is entirely dead. Tiles are allocated as
+ * activity spreads into them and retired when they hold no alive cells.
+ */
+class SparseWorld
+{
+private:
+    static const int tile_size = 64;
+    int width;
+    int height;
+    std::map<std::pair<int, int>, std::vector<Cell>> tiles;
+    Cell get_cell(const int x, const int y, const bool toroidal) const;
+    int count_neighbours(const int x, const int y, const bool toroidal) const;
+
+public:
+    SparseWorld();
+    explicit SparseWorld(const int square_size);
+    SparseWorld(const int width, const int height);
+    SparseWorld(const Grid &initial_state);
+    int get_width() const;
+    int get_height() const;
+    int get_total_cells() const;
+    int get_alive_cells() const;
+    int get_dead_cells() const;
+    int get_stored_tiles() const;
+    const Grid get_state() const;
+    const Cell get(const int x, const int y) const;
+    void set(const int x, const int y, const Cell value);
+    void step(const bool toroidal = false);
+    void advance(const int steps, const bool toroidal = false);
+};
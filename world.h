@@ -13,6 +13,31 @@
 // Add the minimal number of includes you need in order to declare the class.
 // #include ...
 #include "grid.h"
+#include "rule.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Aggregated performance counters for a World, collected while stats are
+ * enabled and read back through World::get_stats().
+ *
+ * The cells_changed per generation number is the signal for deciding when a
+ * workload should move to the sparse engine.
+ */
+struct WorldStats
+{
+    long long generations = 0;
+    long long cells_evaluated = 0;
+    long long cells_changed = 0;
+    long long tiles_evaluated = 0;
+    long long tiles_copied = 0;
+    long long alive_delta = 0;
+    double prepare_seconds = 0;
+    double evaluate_seconds = 0;
+    double swap_seconds = 0;
+};
 /**
  * Declare the structure of the World class for representing a 2d grid world.
  *
@@ -22,23 +47,90 @@
 class World
 {
 private:
+    static const int tile_size = 64;
     Grid current;
     Grid next;
-    int count_neighbours(const int x, const int y, const bool toroidal);
+    int generation = 0;
+    int placement_threads = 0;
+    bool tiles_valid = false;
+    Rule rule;
+    //auto-expansion of the universe when the live region nears an edge
+    bool auto_expand = false;
+    int expand_margin = 0;
+    int expand_chunk = 0;
+    long long origin_x = 0;
+    long long origin_y = 0;
+    //sequence counter for lock-free observation: odd while the current
+    //state is being replaced, even and advanced once it is stable again
+    std::atomic<unsigned long long> read_seq{0};
+    std::vector<char> tile_changed;
+    std::vector<char> tile_eval;
+    Grid checkpoint_grid;
+    int checkpoint_generation = 0;
+    std::thread checkpoint_thread;
+    std::string checkpoint_error;
+    bool stats_enabled = false;
+    WorldStats stats;
+    std::mutex stats_mutex;
+    void write_checkpoint(const std::string path);
+    template <bool Toroidal>
+    int count_neighbours(const int x, const int y);
+    int column_sum(const int x, const int y);
+    Cell next_cell(const Cell cur, const int n) const;
+    template <bool Toroidal>
+    void step_cell(const int x, const int y);
+    template <bool Toroidal>
+    void step_segment(const int y, const int tx, std::vector<unsigned char> &vert, WorldStats &band);
+    template <bool Toroidal>
+    void step_tile(const int tx, const int ty, std::vector<unsigned char> &vert, WorldStats &band);
+    template <bool Toroidal>
+    void step_rows(const int y0, const int y1);
+    void step_rows(const int y0, const int y1, const bool toroidal);
+    void prepare_tiles(const bool toroidal);
+    void copy_row_range(const int xa, const int xb, const int y);
+    bool region_has_alive(const int x0, const int y0, const int x1, const int y1) const;
+    void maybe_expand();
 
 public:
     World();
     explicit World(const int size);
     World(const int width, const int height);
     World(const Grid &initial_state);
+    World(Grid &&initial_state);
+    World(World &&other);
+    World &operator=(World &&other);
+    ~World();
     int get_width() const;
+    int get_generation() const;
     int get_height() const;
     int get_total_cells() const;
     int get_alive_cells() const;
     int get_dead_cells() const;
     const Grid get_state() const;
+    Grid take_state();
+    GridView view() const;
     void resize(const int square_size);
     void resize(const int new_width, const int new_height);
     void step(const bool toroidal = false);
+    void step_parallel(const int n_threads, const bool toroidal = false);
+    void step_region(const int x0, const int y0, const int x1, const int y1,
+                     const int halo = 1, const bool toroidal = false);
     void advance(const int steps, const bool torodial = false);
+    void advance_parallel(const int steps, const bool toroidal = false, const int n_threads = 4);
+    int advance_until_stable(const int max_steps, const bool toroidal = false, const int max_period = 8);
+    void checkpoint(const std::string &path);
+    void wait_for_checkpoint();
+    static Grid load_checkpoint(const std::string &path, int &generation);
+    void first_touch(const int n_threads);
+    void set_rule(const Rule &rule);
+    const Rule &get_rule() const;
+    void set_auto_expand(const int margin, const int chunk);
+    long long get_origin_x() const;
+    long long get_origin_y() const;
+    bool get_bounding_box(int &x0, int &y0, int &x1, int &y1) const;
+    bool try_read(const std::function<void(const GridView &)> &reader) const;
+    void read_consistent(const std::function<void(const GridView &)> &reader) const;
+    void set_stats_enabled(const bool enabled);
+    const WorldStats &get_stats() const;
+    void reset_stats();
 };
\ No newline at end of file
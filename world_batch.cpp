@@ -0,0 +1,186 @@
+/**
+ * Implements a class for advancing many independent World instances over a shared thread pool.
+ *      - Worlds are moved into the batch and owned by it, reachable through get_world.
+ *      - advance_all runs every world forward the same number of steps over a pool of
+ *        threads. Worlds are claimed dynamically from a shared counter, so a thread
+ *        that finishes a quiet world immediately picks up the next one instead of
+ *        idling behind a static partition - the pool stays saturated even when world
+ *        sizes and activity levels are wildly uneven.
+ *      - A completion callback, when given, fires on the pool thread as each world
+ *        finishes, which is where sweep drivers collect their per-world results.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "world_batch.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * WorldBatch::add(world)
+ *
+ * Move a world into the batch, taking ownership of it.
+ *
+ * @example
+ *
+ *      // Build a sweep of worlds seeded at different offsets
+ *      WorldBatch batch;
+ *      for (int i = 0; i < 500; i++) {
+ *          Grid seed(256);
+ *          seed.merge(Zoo::glider(), i % 200, (i * 7) % 200, true);
+ *          batch.add(World(std::move(seed)));
+ *      }
+ *
+ * @param world
+ *      The world to add, moved from.
+ *
+ * @return
+ *      The index of the world within the batch.
+ */
+int WorldBatch::add(World &&world)
+{
+    worlds.push_back(std::move(world));
+    return worlds.size() - 1;
+}
+
+/**
+ * WorldBatch::get_world_count()
+ *
+ * Gets the number of worlds in the batch.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The number of worlds.
+ */
+int WorldBatch::get_world_count() const
+{
+    return worlds.size();
+}
+
+/**
+ * WorldBatch::get_world(index)
+ *
+ * Gets a reference to one world of the batch.
+ *
+ * @param index
+ *      The index of the world, as returned by add.
+ *
+ * @return
+ *      A reference to the world.
+ *
+ * @throws
+ *      std::exception or sub-class if the index is not within the batch.
+ */
+World &WorldBatch::get_world(const int index)
+{
+    if (index < 0 || index >= int(worlds.size()))
+    {
+        throw std::out_of_range("World index out of range");
+    }
+    return worlds[index];
+}
+
+/**
+ * WorldBatch::get_world(index)
+ *
+ * Gets a read-only reference to one world of the batch.
+ * The function should be callable from a constant context.
+ *
+ * @param index
+ *      The index of the world, as returned by add.
+ *
+ * @return
+ *      A read-only reference to the world.
+ *
+ * @throws
+ *      std::exception or sub-class if the index is not within the batch.
+ */
+const World &WorldBatch::get_world(const int index) const
+{
+    if (index < 0 || index >= int(worlds.size()))
+    {
+        throw std::out_of_range("World index out of range");
+    }
+    return worlds[index];
+}
+
+/**
+ * WorldBatch::advance_all(steps, toroidal, n_threads, on_complete)
+ *
+ * Advance every world in the batch the same number of steps over a shared
+ * pool of threads.
+ *
+ * Each pool thread repeatedly claims the next unclaimed world from a shared
+ * atomic counter and advances it to completion, so the assignment of worlds
+ * to threads is dynamic: quiet worlds finish fast and their thread moves
+ * straight on to the next, keeping all cores busy regardless of how uneven
+ * the sweep is. Worlds are independent - each thread touches only the world
+ * it claimed - so no locking is needed around the simulation itself.
+ *
+ * @example
+ *
+ *      // Run the whole sweep 10000 steps on 8 threads, collecting survivors
+ *      batch.advance_all(10000, false, 8, [&](const int index, World &world) {
+ *          results[index] = world.get_alive_cells();
+ *      });
+ *
+ * @param steps
+ *      The number of steps to advance every world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then steps consider each grid as a torus. Defaults to false.
+ *
+ * @param n_threads
+ *      Optional parameter. The number of pool threads. Values below 1 are treated as 1. Defaults to 1.
+ *
+ * @param on_complete
+ *      Optional parameter. Invoked as (index, world) on the pool thread as each world
+ *      finishes its steps. The callback must be safe to run concurrently with itself
+ *      for different worlds. Defaults to none.
+ */
+void WorldBatch::advance_all(const int steps, const bool toroidal, const int n_threads,
+                             const std::function<void(const int, World &)> &on_complete)
+{
+    std::atomic<int> next_world(0);
+    auto worker = [this, steps, toroidal, &next_world, &on_complete]() {
+        while (true)
+        {
+            //claim the next unclaimed world, dynamic assignment is what
+            //keeps the pool saturated on uneven sweeps
+            int index = next_world.fetch_add(1);
+            if (index >= int(worlds.size()))
+            {
+                return;
+            }
+            worlds[index].advance(steps, toroidal);
+            if (on_complete)
+            {
+                on_complete(index, worlds[index]);
+            }
+        }
+    };
+
+    int pool = n_threads < 1 ? 1 : n_threads;
+    if (pool > int(worlds.size()))
+    {
+        pool = worlds.size();
+    }
+    if (pool <= 1)
+    {
+        worker();
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < pool; t++)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
@@ -0,0 +1,35 @@
+/**
+ * Declares a class for advancing many independent World instances over a shared thread pool.
+ * Rich documentation for the api and behaviour the WorldBatch class can be found in world_batch.cpp.
+ *
+ * Parameter sweeps run hundreds of small worlds; launching a process per world pays
+ * startup and scheduling costs and loses cache locality. A WorldBatch owns the worlds
+ * of one sweep and advances them all inside one process, handing worlds to pool
+ * threads dynamically so fast and slow worlds interleave and every core stays busy.
+ *
+ * @author 952283
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include "world.h"
+#include <functional>
+
+/**
+ * Declare the structure of the WorldBatch class for running many worlds on a shared pool.
+ */
+class WorldBatch
+{
+private:
+    std::vector<World> worlds;
+
+public:
+    int add(World &&world);
+    int get_world_count() const;
+    World &get_world(const int index);
+    const World &get_world(const int index) const;
+    void advance_all(const int steps, const bool toroidal = false, const int n_threads = 1,
+                     const std::function<void(const int, World &)> &on_complete = nullptr);
+};
@@ -18,6 +18,25 @@
  *                padded with zero or more 0 bits.
  *              - a 0 bit should be considered Cell::DEAD, a 1 bit should be considered Cell::ALIVE.
  *
+ *      - Grids can be loaded from and saved to the standard Life RLE (.rle) pattern format.
+ *          - RLE files are composed of:
+ *              - zero or more comment lines starting with #
+ *              - a header line "x = <width>, y = <height>" optionally followed by ", rule = ..."
+ *              - run length encoded cell data: an optional count followed by a tag, where
+ *                (b) is a run of dead cells, (o) a run of alive cells, ($) ends a row,
+ *                and (!) ends the pattern. Newlines within the data are ignored.
+ *          - Runs are expanded straight into the Grid while streaming the file, and the
+ *            encoder emits runs as it scans, so neither direction materializes row strings.
+ *
+ *      - Grids can be loaded from and saved to a v2 memory-mapped binary format.
+ *          - v2 binary files are composed of:
+ *              - a 64 byte header: the magic bytes "GOL2", a 4 byte int width, a 4 byte int height,
+ *                and zero padding up to the 64 byte boundary.
+ *              - followed by the cell data laid out exactly as a bit-packed Grid buffer in memory:
+ *                64 bit words of 64 cells each in row major order, padded with 0 bits.
+ *          - Because the payload matches the in-memory layout and is 64-byte aligned, loading is
+ *            a single mmap plus one bulk copy into the Grid words instead of a bit-by-bit parse.
+ *
  * @author 952283
  * @date March, 2020
  */
@@ -25,8 +44,13 @@
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
 #include "zoo.h"
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 /**
  * Zoo::glider()
  *
@@ -122,12 +146,72 @@ Grid Zoo::light_weight_spaceship()
     g.set(3, 3, Cell::ALIVE);
     return g;
 }
+//whether load_ascii keeps and uses preparsed binary sidecars, see set_pattern_cache
+static bool pattern_cache_enabled = true;
+
+/**
+ * Zoo::set_pattern_cache(enabled)
+ *
+ * Turn the transparent pattern cache on or off. While enabled, load_ascii
+ * writes a preparsed v2 binary sidecar next to each ascii file it parses and
+ * loads the sidecar instead on later calls whenever it is at least as new as
+ * the source, falling back to parsing when it is stale or unreadable. A
+ * service loading thousands of patterns at boot goes from line-by-line
+ * parsing to an mmap per pattern with no change to its calling code.
+ *
+ * @param enabled
+ *      Whether sidecars should be written and used. Enabled by default.
+ */
+void Zoo::set_pattern_cache(const bool enabled)
+{
+    pattern_cache_enabled = enabled;
+}
+
+/**
+ * unpack(packed)
+ *
+ * File local helper expanding a bit-packed grid into the byte-per-cell
+ * backend that load_ascii has always returned. All-dead words are skipped
+ * whole, which makes the expansion almost free for the sparse patterns
+ * that dominate pattern libraries.
+ *
+ * @param packed
+ *      The bit-packed grid to expand.
+ *
+ * @return
+ *      The same cells in a byte-per-cell grid.
+ */
+static Grid unpack(const Grid &packed)
+{
+    const int width = packed.get_width();
+    Grid g(width, packed.get_height());
+    const std::uint64_t *words = packed.word_data();
+    for (int i = 0; i < packed.get_total_words(); i++)
+    {
+        std::uint64_t word = words[i];
+        while (word != 0)
+        {
+            //peel the lowest set bit and place its cell
+            int bit = __builtin_ctzll(word);
+            word &= word - 1;
+            long index = (long)i * 64 + bit;
+            g.set(int(index % width), int(index / width), Cell::ALIVE);
+        }
+    }
+    return g;
+}
+
 /**
  * Zoo::load_ascii(path)
  *
  * Load an ascii file and parse it as a grid of cells.
  * Should be implemented using std::ifstream.
  *
+ * While the pattern cache is enabled (the default), a preparsed v2 binary
+ * sidecar at path + ".bgol2" is loaded instead whenever its modification
+ * time says it is fresh, and is (re)written after an actual parse - both
+ * best effort, a missing or unwritable sidecar just means parsing ascii.
+ *
  * @example
  *
  *      // Load an ascii file from a directory
@@ -148,6 +232,23 @@ Grid Zoo::light_weight_spaceship()
  */
 Grid Zoo::load_ascii(const std::string &path)
 {
+    const std::string sidecar = path + ".bgol2";
+    if (pattern_cache_enabled)
+    {
+        struct stat source_info, sidecar_info;
+        if (stat(path.c_str(), &source_info) == 0 && stat(sidecar.c_str(), &sidecar_info) == 0 &&
+            sidecar_info.st_mtime >= source_info.st_mtime)
+        {
+            try
+            {
+                return unpack(load_binary_mmap(sidecar));
+            }
+            catch (const std::exception &ex)
+            {
+                //a corrupt or foreign sidecar is not an error, parse the source
+            }
+        }
+    }
     std::ifstream file;
     file.open(path, std::ios::in);
     if (!file.is_open())
@@ -215,6 +316,18 @@ Grid Zoo::load_ascii(const std::string &path)
     }
 
     file.close();
+    if (pattern_cache_enabled)
+    {
+        try
+        {
+            //keep a preparsed sidecar for the next boot, best effort
+            save_binary_mmap(sidecar, g);
+        }
+        catch (const std::exception &ex)
+        {
+            //an unwritable directory just means no cache
+        }
+    }
     return g;
 }
 /**
@@ -246,6 +359,32 @@ Grid Zoo::load_ascii(const std::string &path)
  *      Throws std::runtime_error or sub-class if the file cannot be opened.
  */
 void Zoo::save_ascii(const std::string &path, const Grid &grid)
+{
+    save_ascii(path, GridView(grid));
+}
+
+/**
+ * Zoo::save_ascii(path, view)
+ *
+ * Save a viewed grid as an ascii .gol file according to the specified file format.
+ * The view overload lets observers save a world state without ever copying it,
+ * pairing with World::view().
+ *
+ * @example
+ *
+ *      // Save the state of a world without copying the grid
+ *      Zoo::save_ascii("path/to/file.gol", world.view());
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param view
+ *      A view of the grid to be written out to file.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be opened.
+ */
+void Zoo::save_ascii(const std::string &path, const GridView &view)
 {
     std::ofstream file;
     file.open(path, std::ios::out);
@@ -254,12 +393,12 @@ void Zoo::save_ascii(const std::string &path, const Grid &grid)
         throw std::runtime_error("Width or height is negative");
     }
 
-    file << grid.get_width() << " " << grid.get_height() << std::endl;
-    for (int y = 0; y < grid.get_height(); y++)
+    file << view.get_width() << " " << view.get_height() << std::endl;
+    for (int y = 0; y < view.get_height(); y++)
     {
-        for (int x = 0; x < grid.get_width(); x++)
+        for (int x = 0; x < view.get_width(); x++)
         {
-            file << char(grid.get(x, y));
+            file << char(view.get(x, y));
         }
         file << std::endl;
     }
@@ -421,4 +560,353 @@ void Zoo::save_binary(const std::string &path, const Grid &grid)
     }
     delete buffer;
     file.close();
-}
\ No newline at end of file
+}
+/**
+ * Zoo::load_binary_mmap(path)
+ *
+ * Load a v2 binary file by memory mapping it.
+ *
+ * The file payload has the exact layout of a bit-packed Grid buffer, so the
+ * load is an mmap of the file followed by one bulk copy of the packed words
+ * into the returned Grid - the kernel pages the data in on demand and no
+ * cell-by-cell conversion happens. The returned Grid uses the bit-packed
+ * storage backend.
+ *
+ * @example
+ *
+ *      // Load a v2 binary file from a directory
+ *      Grid grid = Zoo::load_binary_mmap("path/to/file.bgol2");
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @return
+ *      Returns the parsed grid, bit-packed.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if:
+ *          - The file cannot be opened or mapped.
+ *          - The header magic or sizes do not match the file.
+ */
+Grid Zoo::load_binary_mmap(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Couldn't open file");
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0)
+    {
+        close(fd);
+        throw std::runtime_error("Couldn't stat file");
+    }
+    if (info.st_size < 64)
+    {
+        close(fd);
+        throw std::runtime_error("File too small for a v2 header");
+    }
+    void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close(fd);
+        throw std::runtime_error("Couldn't map file");
+    }
+    //the descriptor is no longer needed once the mapping exists
+    close(fd);
+
+    const char *header = (const char *)mapping;
+    int width, height;
+    std::memcpy(&width, header + 4, 4);
+    std::memcpy(&height, header + 8, 4);
+    if (std::memcmp(header, "GOL2", 4) != 0 || width < 0 || height < 0)
+    {
+        munmap(mapping, info.st_size);
+        throw std::runtime_error("Not a v2 binary grid file");
+    }
+
+    Grid g = Grid(width, height, true);
+    long expected = 64 + (long)g.get_total_words() * 8;
+    if (info.st_size < expected)
+    {
+        munmap(mapping, info.st_size);
+        throw std::runtime_error("Unexpected end of file");
+    }
+    //one bulk copy of the payload, already in the in-memory layout
+    std::memcpy(g.word_data(), header + 64, g.get_total_words() * 8);
+    munmap(mapping, info.st_size);
+    return g;
+}
+
+/**
+ * Zoo::save_binary_mmap(path, grid)
+ *
+ * Save a grid as a v2 binary file through a memory mapping.
+ *
+ * The file is sized up front, mapped, and the packed words are written
+ * straight into the mapping - a single memcpy when the grid is already
+ * bit-packed, or a packing pass when it is byte-per-cell. The payload
+ * starts at the 64 byte boundary so a loader can map it aligned.
+ *
+ * @example
+ *
+ *      // Save a grid to a v2 binary file in a directory
+ *      try {
+ *          Zoo::save_binary_mmap("path/to/file.bgol2", grid);
+ *      }
+ *      catch (const std::exception &ex) {
+ *          std::cerr << ex.what() << std::endl;
+ *      }
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param grid
+ *      The grid to be written out to file.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be created, sized, or mapped.
+ */
+void Zoo::save_binary_mmap(const std::string &path, const Grid &grid)
+{
+    long size = 64 + (long)grid.get_total_words() * 8;
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Couldn't open file");
+    }
+    if (ftruncate(fd, size) < 0)
+    {
+        close(fd);
+        throw std::runtime_error("Couldn't size file");
+    }
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close(fd);
+        throw std::runtime_error("Couldn't map file");
+    }
+    close(fd);
+
+    char *header = (char *)mapping;
+    std::memset(header, 0, 64);
+    std::memcpy(header, "GOL2", 4);
+    int width = grid.get_width();
+    int height = grid.get_height();
+    std::memcpy(header + 4, &width, 4);
+    std::memcpy(header + 8, &height, 4);
+
+    std::uint64_t *words = (std::uint64_t *)(header + 64);
+    if (grid.is_packed())
+    {
+        //already in the file layout, one bulk copy
+        std::memcpy(words, grid.word_data(), grid.get_total_words() * 8);
+    }
+    else
+    {
+        //pack the byte-per-cell buffer into words on the way out
+        std::memset(words, 0, grid.get_total_words() * 8);
+        for (int y = 0; y < height; y++)
+        {
+            const Cell *row = grid.row_data(y);
+            for (int x = 0; x < width; x++)
+            {
+                if (row[x] == Cell::ALIVE)
+                {
+                    long index = (long)y * width + x;
+                    words[index / 64] |= std::uint64_t(1) << (index % 64);
+                }
+            }
+        }
+    }
+    munmap(mapping, size);
+}
+
+/**
+ * Zoo::load_rle(path)
+ *
+ * Load a pattern in the standard Life RLE (.rle) format, the interchange
+ * format of the wider Life ecosystem. Runs are expanded directly into the
+ * Grid as the file streams, no intermediate row strings are built.
+ * Should be implemented using std::ifstream.
+ *
+ * @example
+ *
+ *      // Load a pattern from the community archive
+ *      Grid grid = Zoo::load_rle("path/to/gosperglidergun.rle");
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @return
+ *      Returns the parsed grid.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if:
+ *          - The file cannot be opened.
+ *          - The header is missing or its width or height is not positive.
+ *          - A run tag is unknown or a run leaves the declared bounds.
+ */
+Grid Zoo::load_rle(const std::string &path)
+{
+    std::ifstream file;
+    file.open(path, std::ios::in);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Couldn't open file");
+    }
+
+    //skip comment lines, then parse the "x = <w>, y = <h>" header
+    std::string line;
+    while (getline(file, line) && !line.empty() && line[0] == '#')
+    {
+    }
+    int width = -1, height = -1;
+    std::size_t x_mark = line.find("x");
+    std::size_t y_mark = line.find("y");
+    if (x_mark != std::string::npos && y_mark != std::string::npos)
+    {
+        std::size_t x_eq = line.find('=', x_mark);
+        std::size_t y_eq = line.find('=', y_mark);
+        if (x_eq != std::string::npos && y_eq != std::string::npos)
+        {
+            width = std::atoi(line.c_str() + x_eq + 1);
+            height = std::atoi(line.c_str() + y_eq + 1);
+        }
+    }
+    if (width <= 0 || height <= 0)
+    {
+        throw std::runtime_error("Missing or malformed RLE header");
+    }
+
+    Grid g = Grid(width, height);
+    int x = 0, y = 0;
+    int count = 0;
+    char c;
+    while (file.get(c))
+    {
+        if (c == '\n' || c == '\r')
+        {
+            //newlines within the data carry no meaning
+            continue;
+        }
+        if (c >= '0' && c <= '9')
+        {
+            count = count * 10 + (c - '0');
+            continue;
+        }
+        int run = count > 0 ? count : 1;
+        count = 0;
+        if (c == 'b' || c == 'o')
+        {
+            if (y >= height || x + run > width)
+            {
+                throw std::runtime_error("Run leaves the declared bounds");
+            }
+            //dead cells can be skipped, the grid starts dead
+            if (c == 'o')
+            {
+                for (int i = 0; i < run; i++)
+                {
+                    g.set(x + i, y, Cell::ALIVE);
+                }
+            }
+            x += run;
+        }
+        else if (c == '$')
+        {
+            //a counted $ ends several rows at once
+            y += run;
+            x = 0;
+        }
+        else if (c == '!')
+        {
+            file.close();
+            return g;
+        }
+        else
+        {
+            throw std::runtime_error("Unknown RLE tag");
+        }
+    }
+    //the terminating ! is technically mandatory but files in the wild drop it
+    file.close();
+    return g;
+}
+
+/**
+ * Zoo::save_rle(path, grid)
+ *
+ * Save a grid in the standard Life RLE (.rle) format. The encoder emits
+ * runs while scanning the grid and never materializes a row buffer, and
+ * run length encoding makes sparse patterns orders of magnitude smaller
+ * than the one-byte-per-cell ascii format.
+ * Should be implemented using std::ofstream.
+ *
+ * @example
+ *
+ *      // Save a pattern for the rest of the Life ecosystem
+ *      Zoo::save_rle("path/to/file.rle", grid);
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param grid
+ *      The grid to be written out to file.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be opened.
+ */
+void Zoo::save_rle(const std::string &path, const Grid &grid)
+{
+    std::ofstream file;
+    file.open(path, std::ios::out);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Couldn't open file");
+    }
+
+    const int width = grid.get_width();
+    const int height = grid.get_height();
+    file << "x = " << width << ", y = " << height << ", rule = B3/S23\n";
+
+    //write one run, folding the count-1 shorthand and wrapping lines
+    //around 70 characters the way the community tools do
+    int line_length = 0;
+    for (int y = 0; y < height; y++)
+    {
+        int x = 0;
+        while (x < width)
+        {
+            Cell value = grid.get(x, y);
+            int run = 1;
+            while (x + run < width && grid.get(x + run, y) == value)
+            {
+                run++;
+            }
+            x += run;
+            //a trailing dead run is implied by the end of the row
+            if (value == Cell::DEAD && x == width)
+            {
+                break;
+            }
+            std::string token;
+            if (run > 1)
+            {
+                token = std::to_string(run);
+            }
+            token += value == Cell::ALIVE ? 'o' : 'b';
+            if (line_length + int(token.size()) > 70)
+            {
+                file << "\n";
+                line_length = 0;
+            }
+            file << token;
+            line_length += token.size();
+        }
+        file << (y + 1 < height ? "$" : "!");
+        line_length += 1;
+    }
+    file << "\n";
+    file.close();
+}
@@ -22,10 +22,16 @@ namespace Zoo
 // How to draw an owl:
 //      Step 1. Draw a circle.
 //      Step 2. Draw the rest of the owl.
+void set_pattern_cache(const bool enabled);
 Grid load_ascii(const std::string &path);
 void save_ascii(const std::string &path, const Grid &grid);
+void save_ascii(const std::string &path, const GridView &view);
 Grid load_binary(const std::string &path);
 void save_binary(const std::string &path, const Grid &grid);
+Grid load_binary_mmap(const std::string &path);
+void save_binary_mmap(const std::string &path, const Grid &grid);
+Grid load_rle(const std::string &path);
+void save_rle(const std::string &path, const Grid &grid);
 Grid glider();
 Grid light_weight_spaceship();
 Grid r_pentomino();